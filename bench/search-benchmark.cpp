@@ -0,0 +1,293 @@
+// Google Benchmark suite for the searches. Built by the `bench` target with
+// optimizations on, unlike `performance`.
+//
+// Every search benchmark sweeps grid side x blocked percentage. One
+// iteration is one query, taken round-robin from a fixed set of random
+// start/goal pairs on free cells, so unreachable pairs show up about as
+// often as they would in practice. Reported counters:
+//
+//   nodes/s     cells pushed per second
+//   time/query  wall time per query (e.g. 313.4us)
+//   found       fraction of the queries that had a path
+//
+// e.g.  ./bench --benchmark_filter=a_star --benchmark_repetitions=10
+
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "../incl/maze.hpp"
+#include "../incl/search-context.hpp"
+#include "../incl/search_algorithms.hpp"
+#include "../incl/hierarchical-planner.hpp"
+#include "../incl/bit-wavefront.hpp"
+#include "../incl/parallel-bfs.hpp"
+#include "../incl/parallel-a-star.hpp"
+#include "../incl/landmarks.hpp"
+#include "../incl/flow-field.hpp"
+#include "../incl/sliced-search.hpp"
+#include "../incl/anytime-a-star.hpp"
+
+namespace {
+
+	const int QUERY_COUNT = 256;
+
+	class Scenario {
+		public:
+			std::unique_ptr<Maze>                      maze;
+			std::vector<std::pair<Position, Position>> queries;
+	};
+
+	const Scenario& scenario(int side, int blocked_percent){
+		/*********************************************************************
+		 * Mazes and queries are built once per (side, blocked) and shared  *
+		 * by every algorithm, so each one answers the same queries.        *
+		 *********************************************************************/
+		static std::map<std::pair<int,int>, Scenario> scenarios;
+		Scenario& cached = scenarios[{side, blocked_percent}];
+		if (cached.maze != nullptr){ return cached; }
+
+		cached.maze = std::make_unique<Maze>(
+			Position(0,0), Position(side-1, side-1), side, side, side + blocked_percent, blocked_percent / 100.0);
+
+		std::mt19937 rng(side * 100 + blocked_percent);
+		auto freeCell = [&](){
+			while (true){
+				Position pos(rng() % side, rng() % side);
+				if (!cached.maze->isBlocked(cached.maze->toIndex(pos))){ return pos; }
+			}
+		};
+		while (cached.queries.size() < QUERY_COUNT){
+			Position start = freeCell();
+			Position goal  = freeCell();
+			if (start.row == goal.row && start.col == goal.col){ continue; }
+			cached.queries.push_back({start, goal});
+		}
+		return cached;
+	}
+
+	template<typename Search>
+	void runQueries(benchmark::State& state, Search search){
+		const Scenario& current = scenario(state.range(0), state.range(1));
+		SearchContext   context;
+		size_t          query_i = 0;
+		double          pushes  = 0;
+		double          found   = 0;
+
+		for (auto _: state){
+			const auto&  query  = current.queries[query_i++ % current.queries.size()];
+			SearchResult result = search(*current.maze, context, query.first, query.second);
+			benchmark::DoNotOptimize(result);
+			pushes += result.push_count;
+			found  += result.path_found;
+		}
+
+		state.counters["nodes/s"]    = benchmark::Counter(pushes, benchmark::Counter::kIsRate);
+		state.counters["time/query"] = benchmark::Counter(
+			state.iterations(), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+		state.counters["found"]      = benchmark::Counter(found / state.iterations());
+	}
+
+	typedef SearchResult (*Query)(const Maze&, SearchContext&, Position, Position);
+
+	void BM_Search(benchmark::State& state, Query search){
+		runQueries(state, search);
+	}
+
+	void BM_AStarBuckets(benchmark::State& state){
+		runQueries(state, [](const Maze& maze, SearchContext& context, Position start, Position goal){
+			return Maze::a_star(maze, context, start, goal, Maze::Frontier::BUCKETS);
+		});
+	}
+
+	void BM_AStarEightConnected(benchmark::State& state){
+		runQueries(state, static_cast<Query>(&gridSearch<HeapFrontier, OctileHeuristic, EightConnected, VisitOnPop>));
+	}
+
+	void BM_Hierarchical(benchmark::State& state){
+		const Scenario&     current = scenario(state.range(0), state.range(1));
+		HierarchicalPlanner planner(*current.maze);
+		runQueries(state, [&](const Maze&, SearchContext& context, Position start, Position goal){
+			return planner.search(context, start, goal);
+		});
+	}
+
+	void BM_Landmarks(benchmark::State& state){
+		const Scenario& current = scenario(state.range(0), state.range(1));
+		Landmarks       landmarks(*current.maze, 8);
+		runQueries(state, [&](const Maze&, SearchContext& context, Position start, Position goal){
+			return landmarks.search(context, start, goal);
+		});
+	}
+
+	// A* run to the end in slices of 256 expansions, for the cost of
+	// suspending and resuming compared with BM_Search/a_star.
+	void BM_SlicedAStar(benchmark::State& state){
+		runQueries(state, [](const Maze& maze, SearchContext& context, Position start, Position goal){
+			SearchTask task = slicedAStar(maze, context, start, goal);
+			while (!task.resume(SliceBudget{256})){}
+			return task.result();
+		});
+	}
+
+	// First ARA* iteration (epsilon 3), the path an interactive query gets
+	// right away, and the whole run down to epsilon 1. Compare with
+	// BM_Search/a_star.
+	void BM_AnytimeFirst(benchmark::State& state){
+		runQueries(state, [](const Maze& maze, SearchContext& context, Position start, Position goal){
+			AnytimeAStar anytime(maze, context, start, goal, 3.0, 0.5);
+			return SearchResult(anytime.improve());
+		});
+	}
+
+	void BM_AnytimeToOptimal(benchmark::State& state){
+		runQueries(state, [](const Maze& maze, SearchContext& context, Position start, Position goal){
+			AnytimeAStar anytime(maze, context, start, goal, 3.0, 0.5);
+			while (!anytime.isDone()){ anytime.improve(); }
+			return SearchResult(anytime.result());
+		});
+	}
+
+	// Many agents, one goal: every query keeps its start but heads for the
+	// goal of the first query. The flow field is built on the first query
+	// and read back by the rest; compare with shared_goal/bfs.
+	void BM_SharedGoal(benchmark::State& state, Query search){
+		Position goal = scenario(state.range(0), state.range(1)).queries.front().second;
+		runQueries(state, [&](const Maze& maze, SearchContext& context, Position start, Position){
+			return search(maze, context, start, goal);
+		});
+	}
+
+	void BM_FlowField(benchmark::State& state){
+		const Scenario& current = scenario(state.range(0), state.range(1));
+		Position        goal    = current.queries.front().second;
+		FlowFieldCache  cache(*current.maze);
+		runQueries(state, [&](const Maze&, SearchContext& context, Position start, Position){
+			return cache.search(context, start, goal);
+		});
+	}
+
+	// Distances only (no path), so compare it against bfs for the cost of
+	// finding out how far apart two cells are.
+	void BM_BitWavefront(benchmark::State& state){
+		const Scenario& current = scenario(state.range(0), state.range(1));
+		BitWavefront    wavefront(*current.maze);
+		size_t          query_i = 0;
+		double          found   = 0;
+
+		for (auto _: state){
+			const auto& query    = current.queries[query_i++ % current.queries.size()];
+			int         distance = wavefront.distance(query.first, query.second);
+			benchmark::DoNotOptimize(distance);
+			found += (distance != -1);
+		}
+
+		state.counters["time/query"] = benchmark::Counter(
+			state.iterations(), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+		state.counters["found"]      = benchmark::Counter(found / state.iterations());
+	}
+
+	void BM_BitReachable(benchmark::State& state){
+		const Scenario& current = scenario(state.range(0), state.range(1));
+		BitWavefront    wavefront(*current.maze);
+		size_t          query_i = 0;
+
+		for (auto _: state){
+			const auto& query = current.queries[query_i++ % current.queries.size()];
+			benchmark::DoNotOptimize(wavefront.reachable(query.first));
+		}
+		state.counters["time/query"] = benchmark::Counter(
+			state.iterations(), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+	}
+
+	// Whole-map BFS from a corner, side x threads. Compare with
+	// threads:1 for the scaling and with BM_Search/bfs for the overhead.
+	void BM_ParallelBfs(benchmark::State& state){
+		const Scenario& current = scenario(state.range(0), 20);
+		ParallelBfs     parallel(*current.maze, state.range(1));
+		for (auto _: state){
+			benchmark::DoNotOptimize(parallel.distanceField(Position(0,0)));
+		}
+		state.counters["cells/s"] = benchmark::Counter(
+			double(current.maze->getSize()) * state.iterations(), benchmark::Counter::kIsRate);
+	}
+
+	// Corner to corner A* on one big map, side x threads.
+	void BM_ParallelAStar(benchmark::State& state){
+		int             side    = state.range(0);
+		const Scenario& current = scenario(side, 20);
+		ParallelAStar   parallel(*current.maze, state.range(1));
+		SearchContext   context;
+		Position        goal    = current.maze->toPosition(current.maze->getSize() - 1);
+		for (auto _: state){
+			benchmark::DoNotOptimize(parallel.search(context, Position(0,0), goal));
+		}
+	}
+
+	void BM_Generate(benchmark::State& state){
+		int side = state.range(0);
+		for (auto _: state){
+			Maze maze(Position(0,0), Position(side-1, side-1), side, side, 1, 0.3);
+			benchmark::DoNotOptimize(maze);
+		}
+		state.counters["cells/s"] = benchmark::Counter(
+			double(side) * side * state.iterations(), benchmark::Counter::kIsRate);
+	}
+
+	void BM_GenerateTiled(benchmark::State& state){
+		int side = state.range(0);
+		for (auto _: state){
+			Maze maze = Maze::tiled(Position(0,0), Position(side-1, side-1), side, side, 1, 0.3);
+			benchmark::DoNotOptimize(maze);
+		}
+		state.counters["cells/s"] = benchmark::Counter(
+			double(side) * side * state.iterations(), benchmark::Counter::kIsRate);
+	}
+
+	// Grid side x blocked percentage, repeated for mean/median/stddev.
+	void searchSweep(benchmark::internal::Benchmark* benchmark){
+		benchmark
+			->ArgNames({"side", "blocked%"})
+			->ArgsProduct({{64, 256, 1024}, {0, 20, 35}})
+			->Repetitions(5)
+			->ReportAggregatesOnly(true)
+			->Unit(benchmark::kMicrosecond);
+	}
+
+}
+
+BENCHMARK_CAPTURE(BM_Search, dfs,                  static_cast<Query>(&Maze::dfs))->Apply(searchSweep);
+BENCHMARK_CAPTURE(BM_Search, bfs,                  static_cast<Query>(&Maze::bfs))->Apply(searchSweep);
+BENCHMARK_CAPTURE(BM_Search, a_star,               static_cast<Query>(&Maze::a_star))->Apply(searchSweep);
+BENCHMARK_CAPTURE(BM_Search, dijkstra,             static_cast<Query>(&Maze::dijkstra))->Apply(searchSweep);
+BENCHMARK_CAPTURE(BM_Search, jps,                  static_cast<Query>(&Maze::jps))->Apply(searchSweep);
+BENCHMARK_CAPTURE(BM_Search, bidirectional_bfs,    static_cast<Query>(&Maze::bidirectional_bfs))->Apply(searchSweep);
+BENCHMARK_CAPTURE(BM_Search, bidirectional_a_star, static_cast<Query>(&Maze::bidirectional_a_star))->Apply(searchSweep);
+BENCHMARK(BM_AStarBuckets)->Apply(searchSweep);
+BENCHMARK(BM_AStarEightConnected)->Apply(searchSweep);
+BENCHMARK(BM_SlicedAStar)->Apply(searchSweep);
+BENCHMARK(BM_AnytimeFirst)->Apply(searchSweep);
+BENCHMARK(BM_AnytimeToOptimal)->Apply(searchSweep);
+BENCHMARK(BM_Hierarchical)->Apply(searchSweep);
+BENCHMARK(BM_Landmarks)->Apply(searchSweep);
+BENCHMARK_CAPTURE(BM_SharedGoal, bfs,              static_cast<Query>(&Maze::bfs))->Apply(searchSweep);
+BENCHMARK(BM_FlowField)->Apply(searchSweep);
+BENCHMARK(BM_BitWavefront)->Apply(searchSweep);
+BENCHMARK(BM_BitReachable)->Apply(searchSweep);
+BENCHMARK(BM_ParallelBfs)
+	->ArgNames({"side", "threads"})
+	->ArgsProduct({{1024, 4096}, {1, 2, 4, 8, 16, 32}})
+	->UseRealTime()
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelAStar)
+	->ArgNames({"side", "threads"})
+	->ArgsProduct({{1024, 4096}, {1, 2, 4, 8, 16, 32}})
+	->UseRealTime()
+	->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Generate)->RangeMultiplier(4)->Range(256, 4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GenerateTiled)->RangeMultiplier(4)->Range(256, 4096)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
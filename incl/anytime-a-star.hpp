@@ -0,0 +1,84 @@
+#ifndef ANYTIME_A_STAR_HPP
+#define ANYTIME_A_STAR_HPP
+#include <chrono>
+#include <vector>
+#include "maze.hpp"
+#include "search-context.hpp"
+
+/*
+ *	Anytime Repairing A* (ARA*, Likhachev, Gordon & Thrun, 2003).
+ *
+ *	The first iteration is A* with the Manhattan heuristic inflated by
+ *	epsilon, which finds a path at most epsilon times longer than optimal
+ *	after expanding far fewer cells. Each call to improve() lowers epsilon
+ *	by step and repairs the previous search instead of starting over: cells
+ *	whose g dropped after they had been expanded were kept aside, and only
+ *	they and the open list are looked at again. Once an iteration has run
+ *	with epsilon = 1, the path is optimal.
+ *
+ *	Every result carries the epsilon it was found with and a bound of its
+ *	own: the path is at most bound times longer than optimal, where bound
+ *	is g(goal) over a lower bound on the g+h of the cells still open, and
+ *	never above epsilon.
+ *
+ *	The search tree lives in the context given to the constructor, which
+ *	must not be used for anything else until the planner is dropped. The
+ *	maze must not be edited between iterations.
+ */
+
+class AnytimeResult: public SearchResult {
+	public:
+		double epsilon    = 1;	// heuristic weight of the iteration that found it
+		double bound      = 1;	// path length <= bound * optimal length
+		int    iterations = 0;
+};
+
+class AnytimeAStar {
+
+	private:
+		const Maze&       maze;
+		SearchContext&    tree;		// g, parent, closed and open between iterations
+		int               start_i;
+		int               goal_i;
+		double            epsilon;
+		double            step;
+		std::vector<int>  incons;		// closed cells whose g dropped
+		std::vector<bool> in_incons;
+		AnytimeResult     current;
+		bool              finished = false;
+
+		double heuristic(int cell_i) const;
+		double key(int cell_i) const;
+		void   improvePath();
+		double lowerBound() const;
+
+	public:
+		// @exception std::invalid_argument if epsilon < 1 or step <= 0
+		AnytimeAStar(
+			const Maze&    maze,
+			SearchContext& context,
+			Position       start,
+			Position       goal,
+			double         epsilon = 3.0,
+			double         step    = 0.5
+		);
+
+		AnytimeAStar(const AnytimeAStar&)            = delete;
+		AnytimeAStar& operator=(const AnytimeAStar&) = delete;
+
+		// Runs one iteration with the current epsilon and lowers it for the
+		// next. The path found so far is left in context.path.
+		// @return the result of this iteration
+		const AnytimeResult& improve();
+
+		// True once the path is known to be optimal, or known not to exist.
+		bool isDone() const;
+
+		const AnytimeResult& result() const;
+
+		// Improves until done or until budget has passed. Iterations are not
+		// cut short, so the last one may run past the budget.
+		const AnytimeResult& search(std::chrono::microseconds budget);
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef BATCH_QUERY_HPP
+#define BATCH_QUERY_HPP
+#include <vector>
+#include <span>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "maze.hpp"
+#include "search-context.hpp"
+
+/*
+ *	Answers many (start, goal) queries against one Maze with a fixed pool of
+ *	worker threads. The maze is only ever read, and every worker owns its
+ *	own SearchContext, so workers never share mutable state besides the
+ *	index of the next query to take.
+ */
+
+class PathQuery {
+	public:
+		Position start;
+		Position goal;
+};
+
+class BatchQueryEngine {
+
+	public:
+		typedef SearchResult (*QueryFunction)(const Maze&, SearchContext&, Position, Position);
+
+	private:
+		const Maze&                 maze;
+		QueryFunction               search;
+		std::vector<std::thread>    workers;
+		std::vector<SearchContext>  contexts;		// one per worker
+
+		// State of the batch being answered. Guarded by batch_mutex except
+		// for next_query, which the workers claim queries from.
+		std::mutex                  batch_mutex;
+		std::condition_variable     batch_ready;
+		std::condition_variable     batch_done;
+		std::span<const PathQuery>  queries;
+		std::vector<SearchResult>*  results        = nullptr;
+		std::atomic<size_t>         next_query     = 0;
+		int                         batch_id       = 0;
+		int                         active_workers = 0;
+		bool                        stopping       = false;
+
+		void work(int worker_i);
+
+	public:
+		BatchQueryEngine(
+			const Maze&   maze,
+			int           worker_count = std::thread::hardware_concurrency(),
+			QueryFunction search       = static_cast<QueryFunction>(&Maze::a_star)
+		);
+		~BatchQueryEngine();
+
+		BatchQueryEngine(const BatchQueryEngine&)            = delete;
+		BatchQueryEngine& operator=(const BatchQueryEngine&) = delete;
+
+		size_t workerCount() const;
+
+		// Blocks until every query has been answered. results[i] belongs
+		// to queries[i].
+		std::vector<SearchResult> run(std::span<const PathQuery> queries);
+
+		// Adds up the per-query statistics of a batch.
+		static SearchStats summarize(std::span<const SearchResult> results);
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef BIT_WAVEFRONT_HPP
+#define BIT_WAVEFRONT_HPP
+#include <vector>
+#include <cstdint>
+#include "maze.hpp"
+
+/*
+ *	Bit-parallel BFS for 4-connected, unweighted reachability and distances.
+ *
+ *	Free cells are packed one bit per cell, each row padded to whole 64-bit
+ *	words. One BFS step grows the whole frontier at once: for every word,
+ *
+ *		next = (frontier<<1 | frontier>>1 | row above | row below) & free & ~seen
+ *
+ *	with the bits that cross word boundaries carried over. The first and
+ *	last word of a row are done apart, so the loop over the words between
+ *	them has no branches and the compiler vectorizes it (SSE2 by default,
+ *	AVX2 under -mavx2). Only the rows within one of the frontier are visited.
+ *
+ *	When only the reachable set is wanted, reachable() skips the layers:
+ *	it sweeps the rows down and up, filling each run of free cells a seed
+ *	touches in log2(64) shift steps per word, until nothing changes. A sweep
+ *	handles any path that only turns back vertically once, so open and
+ *	random maps settle in a few sweeps; serpentine corridors need more.
+ *
+ *	The free mask is a snapshot of the maze; edits made with
+ *	Maze::markAsBlocked/markAsEmpty are picked up from the maze's edit log
+ *	at the start of each flood.
+ */
+
+// One bit per cell, row-major, rows padded to whole words.
+class BitGrid {
+
+	private:
+		size_t                rows;
+		size_t                cols;
+		size_t                row_words;
+		std::vector<uint64_t> words;
+
+	public:
+		BitGrid(size_t rows = 0, size_t cols = 0);
+
+		size_t getRows()     const { return rows; }
+		size_t getCols()     const { return cols; }
+		size_t getRowWords() const { return row_words; }
+
+		bool test(size_t row, size_t col) const { return (words[row*row_words + col/64] >> (col%64)) & 1; }
+		void set(size_t row, size_t col, bool value);
+		void clear();
+		size_t count() const;
+
+		uint64_t*       row(size_t row_i)       { return words.data() + row_i*row_words; }
+		const uint64_t* row(size_t row_i) const { return words.data() + row_i*row_words; }
+};
+
+class BitWavefront {
+
+	private:
+		const Maze& maze;
+		BitGrid     free_cells;
+		BitGrid     seen;
+		BitGrid     frontier;
+		BitGrid     next;
+		size_t      seen_edits = 0;
+
+		void refresh();
+
+		// Runs the BFS from source, calling on_layer(distance, row_i, words)
+		// for every row that gained cells. Stops early once target_i is
+		// reached (-1 floods everything). Returns the distance of the last
+		// layer, or of target_i.
+		template<typename OnLayer>
+		int flood(int source_i, int target_i, OnLayer on_layer);
+
+	public:
+		BitWavefront(const Maze& maze);
+
+		// Number of steps from one cell to another, -1 if there is no path.
+		int distance(Position from, Position to);
+
+		// Steps from source to every cell, -1 where it cannot be reached.
+		std::vector<int> distanceField(Position source);
+
+		// Every cell connected to source, without distances.
+		const BitGrid& reachable(Position source);
+
+		// Cells reached by the last call to any of the above.
+		const BitGrid& reached() const;
+};
+
+#endif
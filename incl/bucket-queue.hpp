@@ -0,0 +1,172 @@
+#ifndef BUCKET_QUEUE_HPP
+#define BUCKET_QUEUE_HPP
+/*
+ *	This codebase uses javadoc-style banners. If using doxygen, make
+ *	sure to set JAVADOC_BANNER to YES to get the appropriate hinting
+ *	when using it!
+ */
+
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <cstddef>
+#include "priority-queue.hpp"
+
+/*
+ *	Monotone bucket queue (Dial's algorithm) over integer items in
+ *	[0, capacity), for small non-negative integer keys such as the f-values
+ *	of a unit-cost grid. Every key has its own bucket, and each bucket is
+ *	split again by depth (the g-value of the item) so that, among items with
+ *	the same key, the deepest one comes out first.
+ *
+ *	Inside a key, buckets are indexed by key - depth (the h part of an
+ *	A* f-value) rather than by depth, so their number is bounded by the
+ *	largest heuristic value and Dijkstra, where key == depth, uses one.
+ *	Depths must therefore not exceed keys.
+ *
+ *	insert, decrease_key and remove are O(1). remove_min is amortised O(1)
+ *	as long as keys never drop below the last key removed, which holds for
+ *	A* with a consistent heuristic and for Dijkstra.
+ */
+
+class BucketQueue{
+
+	private:
+
+		class Location{
+			public:
+				int key   = -1;		// -1 when the item is not queued
+				int rest  = -1;		// key - depth
+				int slot  = -1;		// index inside buckets[key][rest]
+		};
+
+		static constexpr int NO_REST = std::numeric_limits<int>::max();
+
+		std::vector<std::vector<std::vector<int>>> buckets;	// [key][key - depth]
+		std::vector<int>      bucket_size;		// items per key
+		std::vector<int>      low_rest;		// lowest possibly non-empty key - depth per key
+		std::vector<Location> location;		// per item
+		int                   min_key  = 0;
+		int                   used_keys = 0;	// buckets touched since reset
+		size_t                count    = 0;
+
+		void take_out(int item){
+			/*****************************************************************
+			 * @brief Unlinks item from its bucket by moving the last item of
+			 * that bucket into its slot.
+			 * Time Complexity: O(1)
+			 *****************************************************************/
+			Location&         loc    = location[item];
+			std::vector<int>& bucket = buckets[loc.key][loc.rest];
+			int               moved  = bucket.back();
+
+			bucket[loc.slot]      = moved;
+			location[moved].slot  = loc.slot;
+			bucket.pop_back();
+
+			bucket_size[loc.key] -= 1;
+			count -= 1;
+			loc = Location();
+		}
+
+		void put(int key, int depth, int item){
+			if (key < 0 || depth < 0){ throw std::invalid_argument("Keys and depths must not be negative"); }
+			if (depth > key)         { throw std::invalid_argument("Depths must not exceed keys"); }
+			if (key >= int(buckets.size())){
+				buckets.resize(key+1);
+				bucket_size.resize(key+1, 0);
+				low_rest.resize(key+1, NO_REST);
+			}
+			int rest = key - depth;
+			if (rest >= int(buckets[key].size())){ buckets[key].resize(rest+1); }
+			if (key+1 > used_keys){ used_keys = key+1; }
+
+			std::vector<int>& bucket = buckets[key][rest];
+			location[item] = Location(key, rest, static_cast<int>(bucket.size()));
+			bucket.push_back(item);
+
+			bucket_size[key] += 1;
+			count += 1;
+			if (rest < low_rest[key]){ low_rest[key] = rest; }
+			if (key < min_key)       { min_key = key; }
+		}
+
+	public:
+		BucketQueue(){}
+		BucketQueue(size_t capacity){ reset(capacity); }
+
+		size_t size()    const { return count; }
+		bool   is_empty()const { return count == 0; }
+
+		void reset(size_t capacity){
+			/*****************************************************************
+			 * @brief Empties the queue and makes room for items in
+			 * [0, capacity). Buckets keep their capacity.
+			 * Time Complexity: O(capacity + buckets used since last reset)
+			 *****************************************************************/
+			for (int key = 0; key < used_keys; key++){
+				for (std::vector<int>& bucket: buckets[key]){ bucket.clear(); }
+				bucket_size[key] = 0;
+				low_rest[key]    = NO_REST;
+			}
+			location.assign(capacity, Location());
+			min_key   = 0;
+			used_keys = 0;
+			count     = 0;
+		}
+
+		bool contains(int item) const{
+			return (location[item].key != -1);
+		}
+
+		int key_of(int item) const{
+			if (!contains(item)){ throw std::out_of_range("Item is not in the queue"); }
+			return location[item].key;
+		}
+
+		void insert(int key, int depth, int item){
+			/*****************************************************************
+			 * @brief Adds item with the given key and tie-breaking depth.
+			 * @exception std::invalid_argument if item is already there, or
+			 * if depth is negative or above key
+			 * Time Complexity: O(1)
+			 *****************************************************************/
+			if (contains(item)){ throw std::invalid_argument("Item is already in the queue"); }
+			put(key, depth, item);
+		}
+
+		void update(int item, int key, int depth){
+			/*****************************************************************
+			 * @brief Inserts item, or moves it to a new key and depth if it
+			 * is already queued.
+			 * Time Complexity: O(1)
+			 *****************************************************************/
+			if (contains(item)){ take_out(item); }
+			put(key, depth, item);
+		}
+
+		void remove(int item){
+			if (contains(item)){ take_out(item); }
+		}
+
+		Entry<int,int> remove_min(){
+			/*****************************************************************
+			 * @brief pops an item with the smallest key, the deepest one if
+			 * there are several.
+			 * @return (key, item)
+			 * @exception std::out_of_range if the queue is empty
+			 * Time Complexity: amortised O(1) for monotone keys
+			 *****************************************************************/
+			if (count == 0){ throw std::out_of_range("Tried to remove from an empty queue"); }
+
+			while (bucket_size[min_key] == 0){ min_key += 1; }
+			while (buckets[min_key][low_rest[min_key]].empty()){ low_rest[min_key] += 1; }
+
+			int item = buckets[min_key][low_rest[min_key]].back();
+			Entry<int,int> return_entry(min_key, item);
+			take_out(item);
+			return return_entry;
+		}
+};
+
+#endif
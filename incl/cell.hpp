@@ -19,38 +19,34 @@ struct Position {
 
 std::string posToString(Position pos);
 
+// A Cell only describes the maze topology. Per-query search state (costs,
+// parents, visited bits) lives in a SearchContext so that several searches
+// can share one Maze.
 class Cell{
 
 	private:
 		Position 	position;
 		Contents 	contents;
-		Cell* 		parent;
 
 	public:
-		double g_n = -1;
-		double h_n = -1;
 		Cell(Contents contents);
 		Cell(Position position, Contents contents);
 		Cell();
 
-		Position getPosition();	
-		Contents getContents();
-		Cell* getParent();
+		Position getPosition() const;	
+		Contents getContents() const;
 
 		void setPosition(int row, int col);
 		void setContents(Contents contents);
 
-		bool isBlocked();
-		bool isGoal();
+		bool isBlocked() const;
+		bool isGoal() const;
 
-		void setParent(Cell& parent_cell);
-		void setParent(Cell* parent_cell);
 		void markOnPath();
 		void markAsBlocked();
 
 		std::string	toString();
 		bool operator==(Cell other);
-		int toInt();		//used for indexing in map
 };
 
 #endif
@@ -0,0 +1,63 @@
+#ifndef D_STAR_LITE_HPP
+#define D_STAR_LITE_HPP
+#include <vector>
+#include <utility>
+#include "maze.hpp"
+#include "search-context.hpp"
+#include "indexed-heap.hpp"
+
+/*
+ *	D* Lite (Koenig & Likhachev, 2002) on a Maze.
+ *
+ *	The planner searches backwards from the goal and keeps its whole search
+ *	tree (g, rhs and the open list) between calls. When cells are blocked or
+ *	freed through Maze::markAsBlocked/markAsEmpty, replan() reads the new
+ *	entries of the maze's edit log, fixes up only the cells around them, and
+ *	keeps expanding until the start is consistent again. How much work a
+ *	replan does depends on how much of the tree the edits invalidate, not on
+ *	the size of the map.
+ *
+ *	The start may move between calls (moveStart), as it does for an agent
+ *	walking along the path.
+ */
+
+class DStarLite {
+
+	private:
+		// Lexicographic (k1, k2) priority from the paper.
+		typedef std::pair<double, double> Key;
+
+		const Maze&           maze;
+		int                   start_i;
+		int                   goal_i;
+		int                   last_start_i;
+		double                km = 0;
+		std::vector<double>   g;
+		std::vector<double>   rhs;
+		IndexedHeap<Key>      open;
+		size_t                seen_edits;
+
+		double heuristic(int from_i, int to_i) const;
+		Key    calculateKey(int cell_i) const;
+		double cost(int from_i, int to_i) const;
+		int    neighbors(int cell_i, int (&out)[4]) const;
+		void   updateVertex(int cell_i, SearchContext& context);
+		void   computeShortestPath(SearchContext& context);
+
+	public:
+		DStarLite(const Maze& maze, Position start, Position goal);
+
+		// The agent moved; the next replan() plans from here.
+		void moveStart(Position start);
+
+		// Applies the edits logged on the maze since the last call and
+		// repairs the plan. context.path gets the path from the current
+		// start; push_count and stats count the open list updates and
+		// expansions of this call only. The rest of the context is unused.
+		SearchResult replan(SearchContext& context);
+
+		// Distance from a cell to the goal, as currently known.
+		double distanceToGoal(Position pos) const;
+};
+
+#endif
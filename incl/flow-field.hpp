@@ -0,0 +1,90 @@
+#ifndef FLOW_FIELD_HPP
+#define FLOW_FIELD_HPP
+#include <list>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include "maze.hpp"
+#include "search-context.hpp"
+
+/*
+ *	Goal-rooted flow fields, for many agents heading to the same cell.
+ *
+ *	A FlowField holds the BFS distance from every cell to one goal and, for
+ *	every cell that can reach it, the direction of a neighbor one step
+ *	closer. It is built once by a BFS from the goal in O(rows*cols); after
+ *	that any start reads its path in O(path length) by following the
+ *	directions.
+ *
+ *	Distances are stored as uint16, next to the 1-byte directions. Paths
+ *	longer than 65534 steps get a clamped distance but still the right
+ *	direction, so only distanceOf() is affected.
+ *
+ *	FlowFieldCache keeps the fields of the most recently used goals. Map
+ *	edits are picked up from the maze's edit log: a field is dropped when an
+ *	edited cell or one of its neighbors could reach its goal, since only
+ *	then can its distances change. Edits in other components keep it.
+ *	The cache is not thread-safe.
+ */
+
+class FlowField {
+
+	public:
+		enum Direction : uint8_t { NONE, UP, DOWN, LEFT, RIGHT };
+
+		static constexpr uint16_t UNREACHABLE  = 0xFFFF;
+		static constexpr uint16_t MAX_DISTANCE = UNREACHABLE - 1;
+
+	private:
+		const Maze&            maze;
+		int                    goal_i;
+		std::vector<uint16_t>  distance;	// UNREACHABLE where the goal cannot be reached
+		std::vector<Direction> direction;
+
+	public:
+		FlowField(const Maze& maze, Position goal);
+
+		int       getGoal() const              { return goal_i; }
+		// -1 if the goal cannot be reached, at most MAX_DISTANCE otherwise.
+		int       distanceOf(int cell_i) const { return distance[cell_i] == UNREACHABLE ? -1 : distance[cell_i]; }
+		Direction directionOf(int cell_i) const{ return direction[cell_i]; }
+		int       nextStep(int cell_i) const;	// -1 at the goal or if unreachable
+
+		// Whether editing cell_i can change this field.
+		bool touches(int cell_i) const;
+
+		// Fills context.path from start to the goal in O(path length). Only
+		// the path, push_count and stats are written, so context.parent and
+		// g are left as they were. Every step followed counts as one push
+		// and one expansion; the BFS that built the field is not counted.
+		SearchResult search(SearchContext& context, Position start) const;
+};
+
+class FlowFieldCache {
+
+	private:
+		const Maze& maze;
+		size_t      capacity;
+		size_t      seen_edits;
+
+		// Most recently used first.
+		std::list<std::shared_ptr<const FlowField>> fields;
+		std::unordered_map<int, std::list<std::shared_ptr<const FlowField>>::iterator> by_goal;
+
+		void refresh();
+
+	public:
+		FlowFieldCache(const Maze& maze, size_t capacity = 16);
+
+		// The field towards goal, built if it is not cached. Shared so that
+		// it stays valid after being evicted or invalidated.
+		std::shared_ptr<const FlowField> field(Position goal);
+
+		size_t size() const;
+
+		// Same contract as Maze::bfs, answered from the goal's field.
+		SearchResult search(SearchContext& context, Position start, Position goal);
+};
+
+#endif
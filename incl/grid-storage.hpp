@@ -0,0 +1,65 @@
+#ifndef GRID_STORAGE_HPP
+#define GRID_STORAGE_HPP
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include "cell.hpp"
+
+/*
+ *	A whole file mapped into memory with mmap. The mapping is private: writes
+ *	through it are copy-on-write and never reach the file.
+ */
+class MappedFile {
+
+	private:
+		std::byte* base = nullptr;
+		size_t     size = 0;
+
+	public:
+		// @exception std::runtime_error if the file cannot be opened or mapped
+		MappedFile(const std::string& path);
+		MappedFile(const MappedFile&)            = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		std::byte* data() const {return base;}
+		size_t     bytes() const{return size;}
+};
+
+/*
+ *	The cells of a Maze, one Contents byte each. They either live in an owned
+ *	vector or point into a MappedFile, so a maze loaded from disk is searched
+ *	where it is mapped. Copying a mapped grid copies its cells into a vector,
+ *	since the copy-on-write pages of a mapping are shared by every pointer
+ *	into it; moving keeps the mapping.
+ */
+class GridStorage {
+
+	private:
+		std::vector<Contents>       owned;
+		std::shared_ptr<MappedFile> mapping;
+		Contents*                   cells = nullptr;
+		size_t                      count = 0;
+
+	public:
+		GridStorage(){}
+		GridStorage(std::vector<Contents>&& cells);	// takes the vector over
+		GridStorage(const GridStorage& other);
+		GridStorage(GridStorage&& other);
+		GridStorage& operator=(GridStorage other);
+
+		// count cells of mapping, starting offset bytes into it.
+		// @exception std::invalid_argument if they do not fit in the file
+		static GridStorage view(std::shared_ptr<MappedFile> mapping, size_t offset, size_t count);
+
+		void resize(size_t size);	// owned, and no longer mapped
+
+		Contents&       operator[](size_t index)      {return cells[index];}
+		const Contents& operator[](size_t index) const{return cells[index];}
+		const Contents* data() const                  {return cells;}
+		size_t          size() const                  {return count;}
+		bool            isMapped() const              {return mapping != nullptr;}
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef HIERARCHICAL_PLANNER_HPP
+#define HIERARCHICAL_PLANNER_HPP
+#include <vector>
+#include <unordered_map>
+#include "maze.hpp"
+#include "search-context.hpp"
+#include "indexed-heap.hpp"
+
+/*
+ *	HPA* (hierarchical path-finding A*) on top of a Maze.
+ *
+ *	The maze is cut into square clusters. Wherever two neighboring clusters
+ *	share a run of free cells on their border, one or two entrance cells are
+ *	picked on each side, and the distances between the entrances of each
+ *	cluster are computed once. A query only runs A* over that abstract graph
+ *	(plus the start and goal), then refines each abstract edge with a BFS
+ *	that stays inside a single cluster.
+ *
+ *	Paths are near-optimal: they always go through entrance cells.
+ *
+ *	Map edits made with Maze::markAsBlocked/markAsEmpty are picked up from
+ *	the maze's edit log. Only the cluster holding the cell, plus any
+ *	neighbor that shares a border with it, is rebuilt.
+ */
+
+class HierarchicalPlanner {
+
+	private:
+
+		class Cluster {
+			public:
+				int                           row0;
+				int                           col0;
+				int                           rows;
+				int                           cols;
+				std::vector<int>              entrances;	// cell indices
+				std::vector<std::vector<int>> partners;		// entrance cells across a border
+				std::vector<std::vector<int>> partner_slots;	// their slots in the cluster across
+				std::vector<int>              distances;	// entrances^2, -1 if unreachable
+		};
+
+		const Maze&                  maze;
+		int                          cluster_size;
+		int                          cluster_rows;
+		int                          cluster_cols;
+		std::vector<Cluster>         clusters;
+		std::unordered_map<int, int> entrance_slot;	// cell -> index in its cluster's entrances
+		std::vector<int>             first_node;	// per cluster, node id of its first entrance
+		int                          node_count   = 0;	// entrances over all clusters
+		size_t                       seen_edits   = 0;
+		int                          build_count  = 0;
+
+		// Scratch for BFS inside one cluster, indexed by local offset.
+		std::vector<int>             local_dist;
+		std::vector<int>             local_parent;
+		std::vector<int>             local_queue;
+
+		// Scratch for the abstract A*, indexed by node id: the entrances in
+		// cluster order, then the start and the goal.
+		std::vector<double>          node_g;
+		std::vector<int>             node_parent;
+		std::vector<int>             node_cell;
+		std::vector<bool>            node_closed;
+		IndexedHeap<double>          node_open;
+
+		int  clusterOf(int cell_i) const;
+		int  localOffset(const Cluster& cluster, int cell_i) const;
+		void borderTransitions(int cluster_k, int neighbor_k, std::vector<std::pair<int,int>>& transitions) const;
+		void clusterBfs(int cluster_k, int from_i);
+		void buildCluster(int cluster_k);
+		void linkPartners(int cluster_k);
+		void numberNodes();
+		int  entranceDistance(int cluster_k, int from_slot, int to_slot) const;
+		void refineSegment(int from_i, int to_i, std::vector<int>& path);
+
+	public:
+		HierarchicalPlanner(const Maze& maze, int cluster_size = 16);
+
+		// Rebuilds the clusters touched by edits made since the last call.
+		// search() does this on its own.
+		void refresh();
+
+		// Path into context.path; only context.path and context.push_count
+		// are used, so this does not pay for per-cell scratch arrays.
+		SearchResult search(SearchContext& context, Position start, Position goal);
+
+		int  clusterCount() const;
+		int  entranceCount() const;
+		int  buildCount() const;	// clusters (re)built so far
+};
+
+#endif
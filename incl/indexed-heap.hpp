@@ -0,0 +1,205 @@
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+/*
+ *	This codebase uses javadoc-style banners. If using doxygen, make
+ *	sure to set JAVADOC_BANNER to YES to get the appropriate hinting
+ *	when using it!
+ */
+
+#include <vector>
+#include <stdexcept>
+#include <cstddef>
+#include "priority-queue.hpp"
+#include "search-stats.hpp"
+
+/*
+ *	A 4-ary min-heap over integer items in [0, capacity) (cell indices for
+ *	the searches in Maze). Keys and items are stored by value in one
+ *	contiguous vector, and a position map from item to heap slot gives
+ *	O(log n) decrease_key, so a search never needs to push duplicates.
+ *
+ *	After reset() the heap does not allocate until it grows past the
+ *	largest size it has had before.
+ */
+
+template<typename K>
+class IndexedHeap{
+
+	private:
+
+		static constexpr int ARITY = 4;
+
+		class Slot{
+			public:
+				K   key;
+				int item;
+		};
+
+		std::vector<Slot> container;
+		std::vector<int>  position;		// item -> slot, -1 if absent
+		size_t            sift_steps = 0;	// only counted with MAZE_INSTRUMENTATION
+
+		static int parent_i(int i){ return (i-1)/ARITY; }
+		static int first_child_i(int i){ return (i*ARITY)+1; }
+
+		void place(int slot_i, Slot slot){
+			container[slot_i]     = slot;
+			position[slot.item]   = slot_i;
+		}
+
+		void sift_up(int slot_i){
+			/*****************************************************************
+			 * @brief Moves the slot at slot_i towards the root until its
+			 * parent has a smaller or equal key. Moves a hole instead of
+			 * swapping, so each level costs one write.
+			 * Time Complexity: O(log n)
+			 *****************************************************************/
+			Slot moving = container[slot_i];
+			while (slot_i > 0){
+				int up_i = parent_i(slot_i);
+				if (!(moving.key < container[up_i].key)){ break; }
+				if constexpr (INSTRUMENTED){ sift_steps += 1; }
+				place(slot_i, container[up_i]);
+				slot_i = up_i;
+			}
+			place(slot_i, moving);
+		}
+
+		void sift_down(int slot_i){
+			/*****************************************************************
+			 * @brief Moves the slot at slot_i towards the leaves until none
+			 * of its children has a smaller key.
+			 * Time Complexity: O(log n)
+			 *****************************************************************/
+			Slot moving = container[slot_i];
+			int  count  = container.size();
+			while (true){
+				int child_i = first_child_i(slot_i);
+				if (child_i >= count){ break; }
+
+				int last_i  = child_i + ARITY < count ? child_i + ARITY : count;
+				int min_i   = child_i;
+				for (int i = child_i+1; i < last_i; i++){
+					if (container[i].key < container[min_i].key){ min_i = i; }
+				}
+
+				if (!(container[min_i].key < moving.key)){ break; }
+				if constexpr (INSTRUMENTED){ sift_steps += 1; }
+				place(slot_i, container[min_i]);
+				slot_i = min_i;
+			}
+			place(slot_i, moving);
+		}
+
+	public:
+		IndexedHeap(){}
+		IndexedHeap(size_t capacity){ reset(capacity); }
+
+		size_t size()    const { return container.size(); }
+		size_t siftSteps() const { return sift_steps; }	// since the last reset
+		bool   is_empty()const { return container.empty(); }
+
+		void reset(size_t capacity){
+			/*****************************************************************
+			 * @brief Empties the heap and makes room for items in
+			 * [0, capacity).
+			 * Time Complexity: O(capacity)
+			 *****************************************************************/
+			container.clear();
+			position.assign(capacity, -1);
+			sift_steps = 0;
+		}
+
+		bool contains(int item) const{
+			return (position[item] != -1);
+		}
+
+		K key_of(int item) const{
+			/*****************************************************************
+			 * @brief Key currently associated with item.
+			 * @exception std::out_of_range if item is not in the heap
+			 *****************************************************************/
+			if (!contains(item)){ throw std::out_of_range("Item is not in the heap"); }
+			return container[position[item]].key;
+		}
+
+		void insert(K key, int item){
+			/*****************************************************************
+			 * @brief Adds item with the given key.
+			 * @exception std::invalid_argument if item is already there
+			 * Time Complexity: O(log n)
+			 *****************************************************************/
+			if (contains(item)){ throw std::invalid_argument("Item is already in the heap"); }
+			container.push_back(Slot(key, item));
+			position[item] = container.size()-1;
+			sift_up(container.size()-1);
+		}
+
+		void decrease_key(int item, K key){
+			/*****************************************************************
+			 * @brief Lowers the key of an item that is already in the heap.
+			 * A larger key is moved down as update() would, so the heap
+			 * stays ordered either way.
+			 * @exception std::out_of_range if item is not in the heap
+			 * Time Complexity: O(log n)
+			 *****************************************************************/
+			if (!contains(item)){ throw std::out_of_range("Item is not in the heap"); }
+			int slot_i = position[item];
+			if (container[slot_i].key < key){ update(item, key); return; }
+			container[slot_i].key = key;
+			sift_up(slot_i);
+		}
+
+		void update(int item, K key){
+			/*****************************************************************
+			 * @brief Inserts item, or moves it to key in whichever direction
+			 * it needs to go if it is already in the heap.
+			 * Time Complexity: O(log n)
+			 *****************************************************************/
+			if (!contains(item)){ insert(key, item); return; }
+			int slot_i = position[item];
+			K   old_key = container[slot_i].key;
+			container[slot_i].key = key;
+			if (key < old_key){ sift_up(slot_i); }
+			else              { sift_down(slot_i); }
+		}
+
+		void remove(int item){
+			/*****************************************************************
+			 * @brief Takes item out of the heap if it is there.
+			 * Time Complexity: O(log n)
+			 *****************************************************************/
+			if (!contains(item)){ return; }
+			int  slot_i = position[item];
+			Slot last   = container.back();
+			container.pop_back();
+			position[item] = -1;
+			if (slot_i == int(container.size())){ return; }
+
+			place(slot_i, last);
+			if (slot_i > 0 && last.key < container[parent_i(slot_i)].key){ sift_up(slot_i); }
+			else                                                          { sift_down(slot_i); }
+		}
+
+		Entry<K,int> min() const{
+			/*****************************************************************
+			 * @brief returns a copy of the smallest (key, item) pair
+			 * @exception std::out_of_range if the heap is empty
+			 *****************************************************************/
+			if (is_empty()){ throw std::out_of_range("Tried to get min from an empty heap"); }
+			return Entry<K,int>(container.front().key, container.front().item);
+		}
+
+		Entry<K,int> remove_min(){
+			/*****************************************************************
+			 * @brief pops the (key, item) pair with the smallest key
+			 * @exception std::out_of_range if the heap is empty
+			 * Time Complexity: O(log n)
+			 *****************************************************************/
+			Entry<K,int> return_entry = this->min();
+			remove(return_entry.value);
+			return return_entry;
+		}
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef LANDMARKS_HPP
+#define LANDMARKS_HPP
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include "maze.hpp"
+#include "search-context.hpp"
+#include "grid-storage.hpp"
+
+/*
+ *	ALT (A*, landmarks, triangle inequality) for mazes with many walls, where
+ *	Manhattan distance badly underestimates and A* degrades to BFS.
+ *
+ *	A few landmark cells are picked far apart from each other, and the BFS
+ *	distance from every landmark L to every cell is stored. For any cells a
+ *	and b, d(a,b) >= |d(L,b) - d(L,a)|, so the largest such bound over the
+ *	landmarks (and Manhattan) is an admissible, consistent heuristic.
+ *
+ *	Distances are stored as uint16, cell-major (the landmarks of one cell
+ *	are next to each other). Distances past 65534 are clamped, which only
+ *	weakens the bound; cells a landmark cannot reach hold UNREACHABLE and
+ *	that landmark is skipped for them. Landmarks are placed in the largest
+ *	component; queries elsewhere fall back to Manhattan.
+ *
+ *	Tables can be saved with the maze (Maze::save) and mapped back with
+ *	open(). Map edits make the tables wrong, so search() rebuilds them when
+ *	the maze's edit log has grown.
+ */
+
+class Landmarks {
+
+	public:
+		static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+	private:
+		const Maze&                 maze;
+		std::vector<int>            cells;		// one per landmark
+		int                         requested = 0;	// count asked for; cells may hold fewer
+		std::vector<uint16_t>       owned;
+		std::shared_ptr<MappedFile> mapping;	// when the tables live in a file
+		const uint16_t*             table = nullptr;
+		size_t                      seen_edits;
+
+		// No tables yet; open() fills them in from a file.
+		class Unbuilt{};
+		Landmarks(const Maze& maze, Unbuilt);
+		void build(int count);
+
+	public:
+		Landmarks(const Maze& maze, int count = 8);
+
+		Landmarks(const Landmarks&)            = delete;
+		Landmarks& operator=(const Landmarks&) = delete;
+		Landmarks(Landmarks&&)                 = default;
+
+		// Maps the tables saved along with maze in a Maze::save file.
+		// Defined in src/maze-file.cpp, next to the file layout it reads.
+		// @exception std::invalid_argument if the file has no tables for a
+		// maze of this size
+		static Landmarks open(const Maze& maze, const std::string& path);
+
+		int                     count() const   { return cells.size(); }
+		const std::vector<int>& getCells() const{ return cells; }
+		const uint16_t*         data() const    { return table; }	// cells*count()
+		bool                    isMapped() const{ return mapping != nullptr; }
+
+		uint16_t distance(int landmark_k, int cell_i) const{ return table[size_t(cell_i)*cells.size() + landmark_k]; }
+
+		// Rebuilds the tables if the maze was edited since they were built,
+		// placing as many landmarks as were first asked for.
+		void refresh();
+
+		// A* with the landmark heuristic. Same contract as Maze::a_star.
+		SearchResult search(SearchContext& context, Position start, Position goal);
+};
+
+// Heuristic policy for gridSearch (incl/search_algorithms.hpp).
+class LandmarkHeuristic {
+	private:
+		const Maze&           maze;
+		const Landmarks&      landmarks;
+		Position              goal;
+		std::vector<uint16_t> to_goal;		// distance from each landmark to goal
+
+	public:
+		LandmarkHeuristic(const Maze& maze, const Landmarks& landmarks, Position goal);
+		double operator()(int cell_i) const{
+			double          bound = maze.manhattan(maze.toPosition(cell_i), goal);
+			const uint16_t* row   = landmarks.data() + size_t(cell_i)*to_goal.size();
+			for (size_t landmark_k = 0; landmark_k < to_goal.size(); landmark_k++){
+				if (row[landmark_k] == Landmarks::UNREACHABLE || to_goal[landmark_k] == Landmarks::UNREACHABLE){ continue; }
+				double difference = std::abs(int(row[landmark_k]) - int(to_goal[landmark_k]));
+				bound = std::max(bound, difference);
+			}
+			return bound;
+		}
+};
+
+#endif
@@ -3,6 +3,10 @@
 #include <cstddef>
 #include <stdexcept>
 #include <string>
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
 
 template<typename T>
 class Node{
@@ -19,22 +23,109 @@ class Node{
 		}
 };
 
+/*
+ *	Recycles list nodes. Nodes are allocated CHUNK at a time and handed back
+ *	to a free list when a list removes them, so lists sharing a pool stop
+ *	allocating once the pool has grown to their combined peak size. The pool
+ *	must outlive every list that uses it.
+ */
+template<typename T>
+class NodePool{
+	private:
+		static constexpr size_t CHUNK = 256;
+
+		std::allocator<Node<T>> allocator;
+		std::vector<Node<T>*>   chunks;
+		std::vector<Node<T>*>   free_nodes;
+
+	public:
+		NodePool(){}
+		NodePool(const NodePool&)            = delete;
+		NodePool& operator=(const NodePool&) = delete;
+
+		~NodePool(){
+			for (Node<T>* chunk: chunks){ allocator.deallocate(chunk, CHUNK); }
+		}
+
+		Node<T>* acquire(T value){
+			if (free_nodes.empty()){
+				Node<T>* chunk = allocator.allocate(CHUNK);
+				chunks.push_back(chunk);
+				for (size_t i = CHUNK; i > 0; i--){ free_nodes.push_back(chunk + i - 1); }
+			}
+			Node<T>* slot = free_nodes.back();
+			free_nodes.pop_back();
+			return new (slot) Node<T>(value);
+		}
+
+		void release(Node<T>* node){
+			node->~Node<T>();
+			free_nodes.push_back(node);
+		}
+
+		size_t capacity() const {return chunks.size() * CHUNK;}
+};
+
 template<typename T>
 class LinkedList{
 	private:
-		Node<T>* head;
-		Node<T>* tail;
-		size_t size;
+		Node<T>*     head;
+		Node<T>*     tail;
+		size_t       size;
+		NodePool<T>* pool;	// nullptr: plain new/delete
+
+		Node<T>* newNode(T value){
+			if (pool == nullptr){ return new Node<T>(value); }
+			return pool->acquire(value);
+		}
+
+		void freeNode(Node<T>* node){
+			if (pool == nullptr){ delete node; return; }
+			pool->release(node);
+		}
+
 	public:
-		LinkedList(): head{nullptr}, tail{nullptr}, size{0}{}
-	
+		LinkedList(NodePool<T>* pool = nullptr): head{nullptr}, tail{nullptr}, size{0}, pool{pool}{}
+
+		LinkedList(const LinkedList& other): LinkedList(other.pool){
+			for (Node<T>* cur_node = other.head; cur_node != nullptr; cur_node = cur_node->next){
+				this->addRight(cur_node->data);
+			}
+		}
+
+		LinkedList(LinkedList&& other): head{other.head}, tail{other.tail}, size{other.size}, pool{other.pool}{
+			other.head = nullptr;
+			other.tail = nullptr;
+			other.size = 0;
+		}
+
+		LinkedList& operator=(LinkedList other){
+			std::swap(head, other.head);
+			std::swap(tail, other.tail);
+			std::swap(size, other.size);
+			std::swap(pool, other.pool);
+			return *this;
+		}
+
+		~LinkedList(){ this->clear(); }
+
+		void clear(){
+			while (head != nullptr){
+				Node<T>* next = head->next;
+				freeNode(head);
+				head = next;
+			}
+			tail = nullptr;
+			size = 0;
+		}
+
 		int      getSize(){return size;}
 		Node<T>* getHead(){return head;}
 		Node<T>* getTail(){return tail;}
 		bool     isEmpty(){return (size == 0);}
 		
 		void addLeft(T value){
-			Node<T>* new_node = new Node<T>(value);
+			Node<T>* new_node = newNode(value);
 			if (head == nullptr){
 				size ++;
 				head = new_node; 
@@ -48,7 +139,7 @@ class LinkedList{
 		}
 
 		void addRight(T value){
-			Node<T>* new_node = new Node<T>(value);
+			Node<T>* new_node = newNode(value);
 			if (head == nullptr){
 				size ++;
 				head = new_node; 
@@ -67,14 +158,14 @@ class LinkedList{
 			}
 			T return_data = head->data;
 			if (size == 1){
-				delete head;
+				freeNode(head);
 				head = nullptr;
 				tail = nullptr;
 				size --;
 				return return_data;
 			}
 			Node<T>& new_head = *head->next;
-			delete head;
+			freeNode(head);
 			head = &new_head;
 			head->prev = nullptr;
 			size --;
@@ -87,14 +178,14 @@ class LinkedList{
 			}
 			T return_data  = tail->data;
 			if (size == 1){
-				delete tail;
+				freeNode(tail);
 				head = nullptr;
 				tail = nullptr;
 				size --;
 				return return_data;
 			}
 			Node<T>* new_tail_ptr = tail->prev;
-			delete tail;
+			freeNode(tail);
 			tail = new_tail_ptr;
 			new_tail_ptr->next = nullptr;
 			size --;
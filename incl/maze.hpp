@@ -1,52 +1,82 @@
 #ifndef MAZE_CPP
 #define MAZE_CPP
 #include <vector>
+#include <array>
 #include <optional>
-#include <map>
+#include <string>
+#include <iosfwd>
+#include <cstdint>
+#include <thread>
 #include "cell.hpp"
 #include "stack.hpp"
 #include "queue.hpp"
-#include "../incl/priority-queue.hpp"
+#include "search-context.hpp"
+#include "indexed-heap.hpp"
+#include "grid-storage.hpp"
+
+class Landmarks;
 
 class Maze {
 	private:
 
 		Position          start;
 		Position          goal;
-		std::vector<Cell> grid;		//Vector allows size definition at runtime.
+		// One byte per cell, row-major. Positions are derived from the index,
+		// and search state lives in a SearchContext, so nothing else is
+		// stored per cell.
+		GridStorage       grid;
+		Cell              goal_cell;	// returned by the Maze* searches
 		size_t            rows;
 		size_t            cols;
-		
-
-		// The queues and stacks are pointer instantiated because vectors cannot
-		// be instantiated with references.
-		void pushSearchLocations(
-			Cell*                cell, 
-			Stack<Cell*>&        search_stack, 
-			std::map<int, bool>& searched_index
-		);
 
-		// Queue overload for BFS
-		void pushSearchLocations(
-			Cell*                cell, 
-			Queue<Cell*>&        search_queue, 
-			std::map<int, bool>& searched_index
-		);
+		// Scratch space used by the Maze* overloads of the searches, which
+		// keep their result around for showPath()/toString().
+		SearchContext     last_search;
 
-		void pushSearchLocations(
-			Cell*                         cell, 
-			PriorityQueue<double, Cell*>& search_queue, 
-			std::map<int, double>&   searched_index
-		);
+		// Every cell changed through markAsBlocked/markAsEmpty, in order.
+		// Structures built on top of the maze remember how much of it they
+		// have seen and only redo the parts touched since then.
+		std::vector<int>  edits;
+
+		// Connected component of every cell (-1 if blocked), so that queries
+		// between two components return at once instead of flooding the
+		// start's component. Kept up to date by markAsBlocked/markAsEmpty.
+		// Empty until labelComponents() runs. Labels are below labelBound()
+		// but not dense: labels freed by edits are reused by later ones.
+		std::vector<int>      component;
+		std::vector<int>      component_size;	// by label, 0 once a label is unused
+		std::vector<int>      free_labels;
+		int                   component_count = 0;
+
+		// Which of the floods of the last split reached a cell, by stamp.
+		std::vector<uint32_t> flood_mark;
+		uint32_t              flood_stamp = 0;
 
-		void updatePath();
+		int  floodComponent(int from_i, int label);
+		int  newLabel();
+		void dropLabel(int label);
+		// Relabels what old_label splits into around a newly blocked cell.
+		// Linear in the smaller pieces when it splits; linear in the
+		// component when the seeds only reconnect far from the cell.
+		void splitComponent(int old_label, const std::array<int, 4>& seeds, int seed_count);
+
+		std::optional<Cell*> updatePath(const SearchResult& result);
+
+		// Checks the arguments and sets up an empty grid; the public
+		// constructor and tiled() fill it in.
+		class Unfilled{};
+		Maze(Position start_pos, Position goal_pos, size_t rows, size_t cols, Unfilled);
 
 	public:
+		// Open list used by a_star and dijkstra. BUCKETS needs integer
+		// costs, which is always the case on this grid.
+		enum class Frontier { HEAP, BUCKETS };
+
 		void resetStats();
 
 		bool              path_found = false;
-		int               path_length;
-		int               push_count;
+		int               path_length = 0;
+		int               push_count  = 0;
 
 		Maze(
 			Position 	start_pos           = Position(0,0),
@@ -57,20 +87,123 @@ class Maze {
 			float		blocked_proportion  = 0.2
 		);
 
+		// Parallel generation for very large grids. Each cell is blocked
+		// independently with probability blocked_proportion; the result
+		// depends on seed only, whatever thread_count is.
+		static Maze tiled(
+			Position 	start_pos,
+			Position 	goal_pos,
+			size_t		rows,
+			size_t		cols,
+			uint64_t	seed,
+			float		blocked_proportion  = 0.2,
+			unsigned	thread_count        = std::thread::hardware_concurrency()
+		);
+
 		void   showPath();
-		Cell&  getCell(int row, int col);
-		size_t getRows();
-		size_t getCols();
-		size_t getSize();
+		Cell   getCell(int row, int col) const;	// a copy; edit through markAsBlocked/markAsEmpty
+		size_t getRows() const;
+		size_t getCols() const;
+		size_t getSize() const;
+		int      toIndex(Position pos) const;	// row*cols+col, used for search tables
+		Position toPosition(int index) const;
+		bool     isBlocked(int index) const;
 		double manhattan(Cell* n);
+		double manhattan(Position from, Position to) const;
 
-		// These are pointers instead of references because you cannot have 
+		// Map edits, recorded in the edit log. They must not run while queries
+		// are running on the maze.
+		void markAsBlocked(int row, int col);
+		void markAsEmpty(int row, int col);
+		const std::vector<int>& getEdits() const;
+
+		// Labels the components from scratch in O(rows*cols). The
+		// constructors do it; open() does not, to keep loading O(1).
+		void labelComponents();
+		bool hasComponents() const;
+
+		// Whether a path can exist between two cells. Blocked cells are not
+		// connected to anything. O(1). Without labels every pair counts as
+		// connected, so the searches just run.
+		bool connected(Position from, Position to) const;
+		int  componentOf(Position pos) const;	// -1 if blocked or unlabeled
+		int  componentCount() const;
+		int  labelBound() const;		// every label is below it
+		int  componentSize(int label) const;	// 0 for labels not in use
+
+		// Parent of a cell on the path found by the last Maze* search.
+		std::optional<Position> getParent(int row, int col);
+
+		// These are pointers instead of references because you cannot have
 		// optional references in c++.
 		static std::optional<Cell*> dfs(Maze* maze);
 		static std::optional<Cell*> bfs(Maze* maze);
 		static std::optional<Cell*> a_star(Maze* maze);
+		static std::optional<Cell*> jps(Maze* maze);
+		static std::optional<Cell*> bidirectional_bfs(Maze* maze);
+		static std::optional<Cell*> bidirectional_a_star(Maze* maze);
+
+		// Read-only queries. They never modify the maze, so any number of them
+		// can run at once on the same Maze, each with its own context.
+		static SearchResult dfs   (const Maze& maze, SearchContext& context, Position start, Position goal);
+		static SearchResult bfs   (const Maze& maze, SearchContext& context, Position start, Position goal);
+		static SearchResult a_star(const Maze& maze, SearchContext& context, Position start, Position goal);
+		static SearchResult a_star(const Maze& maze, SearchContext& context, Position start, Position goal, Frontier frontier);
+		static SearchResult dijkstra(const Maze& maze, SearchContext& context, Position start, Position goal);
+		static SearchResult dijkstra(const Maze& maze, SearchContext& context, Position start, Position goal, Frontier frontier);
 
+		// Jump Point Search (src/jump-point-search.cpp). Same path lengths as
+		// a_star, but only jump points are pushed.
+		static SearchResult jps   (const Maze& maze, SearchContext& context, Position start, Position goal);
+
+		// Searches from both ends at once (src/bidirectional-search.cpp). The
+		// goal side lives in context.backward; context.path holds the joined
+		// path.
+		static SearchResult bidirectional_bfs   (const Maze& maze, SearchContext& context, Position start, Position goal);
+		static SearchResult bidirectional_a_star(const Maze& maze, SearchContext& context, Position start, Position goal);
+
+		// Draws the grid in the BOXED format, with the path of the last
+		// Maze* search drawn as PATH cells.
 		std::string toString();
+
+		// Text mazes (src/maze-text.cpp). BOXED is the toString() layout,
+		// "| S |   | x |" with 4 chars per cell. COMPACT has one char per
+		// cell, '.' for empty ones. Every row ends with a newline.
+		//
+		// The writers emit rows from a single row buffer (or straight into
+		// the caller's buffer, which needs textSize() bytes). The readers
+		// take exactly one start and one goal; PATH cells read as empty.
+		enum class TextFormat { BOXED, COMPACT };
+
+		size_t      textSize(TextFormat format = TextFormat::BOXED) const;
+		void        writeText(char* buffer, TextFormat format = TextFormat::BOXED) const;
+		void        writeText(std::ostream& out, TextFormat format = TextFormat::BOXED) const;
+		static Maze readText(std::istream& in, TextFormat format = TextFormat::BOXED);
+		static Maze readText(const char* text, size_t size, TextFormat format = TextFormat::BOXED);
+
+		// Binary maze files (src/maze-file.cpp). The layout, little-endian:
+		//
+		//   offset  0  char[8]   magic "AMAZEBIN"
+		//           8  uint32    version (2)
+		//          12  uint32    offset of the cells (64)
+		//          16  uint64    rows
+		//          24  uint64    cols
+		//          32  int32[4]  start row, start col, goal row, goal col
+		//          48  uint32    landmark count k, 0 if none
+		//          52  uint32    zero
+		//          56  uint64    offset of the landmarks (8-aligned, after the cells)
+		//          64  uint8[rows*cols] Contents, row-major
+		//
+		//   landmarks  int32[k]  landmark cells, zero-padded to 8 bytes
+		//              uint16[rows*cols*k] distances, cell-major
+		//
+		// The cells use the same bytes as the grid in memory, so open()
+		// maps the file and searches it in place. Edits made to an opened
+		// maze stay in memory (copy-on-write) and never reach the file.
+		// Landmark tables (incl/landmarks.hpp) are mapped the same way by
+		// Landmarks::open. Version 1 files, without landmarks, still open.
+		void        save(const std::string& path, const Landmarks* landmarks = nullptr) const;
+		static Maze open(const std::string& path);
 };
 
 
@@ -0,0 +1,95 @@
+#ifndef PARALLEL_A_STAR_HPP
+#define PARALLEL_A_STAR_HPP
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include "maze.hpp"
+#include "search-context.hpp"
+#include "indexed-heap.hpp"
+
+/*
+ *	Hash-distributed A* (HDA*) for single queries across large maps.
+ *
+ *	Every cell is owned by one worker, picked by hashing the 4x4 block the
+ *	cell is in (blocks rather than single cells, so that most neighbors stay
+ *	with the same owner). Only the owner ever writes a cell's g and parent
+ *	or keeps it in its open list. A worker expanding a cell relaxes the
+ *	neighbors it owns itself and sends the others, in one batch per owner,
+ *	to that owner's mailbox: a lock-free stack of batches that the owner
+ *	empties with a single exchange.
+ *
+ *	Cost of the best path found so far (the incumbent) is shared. A worker
+ *	is idle when its open list is empty or its best f is no better than the
+ *	incumbent. A single counter holds the number of busy workers plus the
+ *	number of batches in flight: a batch counts from the moment it is sent
+ *	until it has been applied, and a worker waking up for a batch counts
+ *	itself busy before the batch stops counting. The counter can only reach
+ *	zero when no work is left anywhere, and at that point every open node
+ *	has f >= incumbent, so with the admissible Manhattan heuristic the
+ *	incumbent is optimal. Idle workers sleep on an atomic wait until mail
+ *	comes or the counter reaches zero.
+ *
+ *	Threads are started for every search, the calling thread included. The
+ *	maze must not be edited during a search.
+ */
+
+class ParallelAStar {
+
+	private:
+
+		class Message {
+			public:
+				int    cell_i;
+				int    parent_i;
+				double g;
+		};
+
+		class Batch {
+			public:
+				std::vector<Message> messages;
+				Batch*               next = nullptr;
+		};
+
+		class Worker {
+			public:
+				IndexedHeap<double>               open;
+				std::atomic<Batch*>               mailbox = nullptr;
+				std::atomic<unsigned>             wakeups = 0;	// bumped on mail and at the end
+				std::vector<std::vector<Message>> outbox;	// per owner
+				int                               pushed   = 0;
+				int                               expanded = 0;
+		};
+
+		const Maze&                          maze;
+		unsigned                             thread_count;
+		std::vector<std::unique_ptr<Worker>> workers;
+
+		// State of the search in progress.
+		SearchContext*      context = nullptr;
+		int                 goal_i  = -1;
+		std::atomic<double> best;
+		std::atomic<int>    active;
+
+		unsigned ownerOf(int cell_i) const;
+		void     relax(Worker& worker, const Message& message);
+		void     send(Worker& worker);
+		void     wake(Worker& worker);
+		void     finishWork(int units);
+		void     work(unsigned worker_i);
+
+	public:
+		ParallelAStar(const Maze& maze, unsigned thread_count = std::thread::hardware_concurrency());
+		~ParallelAStar();
+
+		ParallelAStar(const ParallelAStar&)            = delete;
+		ParallelAStar& operator=(const ParallelAStar&) = delete;
+
+		unsigned threadCount() const;
+
+		// Same contract as Maze::a_star. The path is optimal, though which of
+		// several optimal paths is found depends on thread timing.
+		SearchResult search(SearchContext& context, Position start, Position goal);
+};
+
+#endif
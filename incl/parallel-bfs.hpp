@@ -0,0 +1,66 @@
+#ifndef PARALLEL_BFS_HPP
+#define PARALLEL_BFS_HPP
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include "maze.hpp"
+#include "search-context.hpp"
+
+/*
+ *	Level-synchronous BFS over several threads, for single searches on maps
+ *	too large for one core to flood quickly.
+ *
+ *	Each level of the frontier is cut into chunks that the threads claim
+ *	with an atomic counter. A thread claims a neighbor by setting its bit in
+ *	a shared visited bitset with fetch_or, so every cell is taken by exactly
+ *	one thread, which then owns its distance and parent. New cells go into
+ *	a buffer per thread. Between levels every thread copies its buffer into
+ *	the next frontier at an offset given by the sizes of the buffers before
+ *	it, so merging takes no lock. Two barriers separate the phases.
+ *
+ *	Distances match Maze::bfs. Paths have the same length, but which of
+ *	several shortest paths is found depends on the thread timing.
+ *
+ *	Threads are started for every search, with the calling thread taking
+ *	part, so this pays off on big maps only. The maze must not be edited
+ *	during a search.
+ */
+
+class ParallelBfs {
+
+	private:
+		const Maze&                        maze;
+		unsigned                           thread_count;
+		std::vector<std::atomic<uint64_t>> visited;
+		std::vector<int>                   frontier;
+		std::vector<int>                   next;
+		std::vector<std::vector<int>>      local_next;	// one per thread
+		std::vector<size_t>                offsets;		// of local_next[i] in next
+		std::atomic<size_t>                next_chunk = 0;
+
+		bool claim(int cell_i);
+
+		// Floods from source_i until target_i is claimed (-1 for the whole
+		// component), storing distances in distance and, when given,
+		// parents in parent. Both are indexed by cell and must hold -1.
+		// Each level is counted in stats once it has been expanded.
+		template<typename DistanceT>
+		int flood(int source_i, int target_i, std::vector<DistanceT>& distance, std::vector<int>* parent, QueryStats& stats);
+
+	public:
+		ParallelBfs(const Maze& maze, unsigned thread_count = std::thread::hardware_concurrency());
+
+		ParallelBfs(const ParallelBfs&)            = delete;
+		ParallelBfs& operator=(const ParallelBfs&) = delete;
+
+		unsigned threadCount() const;
+
+		// Same contract as Maze::bfs.
+		SearchResult search(SearchContext& context, Position start, Position goal);
+
+		// Steps from source to every cell, -1 where it cannot be reached.
+		std::vector<int> distanceField(Position source);
+};
+
+#endif
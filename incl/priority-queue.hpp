@@ -241,8 +241,8 @@ class PriorityQueue{
 				}
 				if (right_i > 0 && left_i > 0){
 					DEBUG_MSG("Has left and right child");
-					int right_key = container[right_i]->key;
-					int left_key  = container[left_i]->key;
+					K right_key = container[right_i]->key;
+					K left_key  = container[left_i]->key;
 					swap_i = right_key > left_key ? left_i : right_i;
 				}
 
@@ -1,18 +1,59 @@
 #ifndef QUEUE_HPP
 #define QUEUE_HPP
-#include "linked-lists.hpp"
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+/*
+ *	FIFO queue on a ring buffer. The buffer doubles when it is full and never
+ *	shrinks, so once a queue has held its largest frontier push and pop do
+ *	not allocate. clear() keeps the buffer for the next search.
+ */
 
 template <typename T>
 class Queue{
 	private:
-		LinkedList<T> list;
+		std::vector<T> data;	// capacity is 0 or a power of two
+		size_t         head  = 0;
+		size_t         count = 0;
+
+		void grow(){
+			/*****************************************************************
+			 * @brief Doubles the buffer, unwrapping the elements so that the
+			 * head is at 0 again.
+			 * Time Complexity: O(n)
+			 *****************************************************************/
+			std::vector<T> bigger(data.empty() ? 16 : data.size() * 2);
+			for (size_t i = 0; i < count; i++){
+				bigger[i] = data[(head + i) & (data.size() - 1)];
+			}
+			data.swap(bigger);
+			head = 0;
+		}
 
 	public:
-		void push(T element){list.addRight(element);}
-		T pop()             {return list.removeLeft();}
-		T& top()            {return list.getHead();}
-		bool isEmpty()      {return list.isEmpty();}
-		int size()          {return list.getSize();}
+		void push(T element){
+			if (count == data.size()){ grow(); }
+			data[(head + count) & (data.size() - 1)] = element;
+			count ++;
+		}
+
+		T pop(){
+			if (count == 0){ throw std::length_error("Cannot pop from an empty queue"); }
+			T return_val = data[head];
+			head = (head + 1) & (data.size() - 1);
+			count --;
+			return return_val;
+		}
+
+		T& top(){
+			if (count == 0){ throw std::length_error("Empty queue has no top"); }
+			return data[head];
+		}
 
+		bool   isEmpty()  {return (count == 0);}
+		int    size()     {return count;}
+		size_t capacity() {return data.size();}
+		void   clear()    {head = 0; count = 0;}
 };
 #endif
@@ -0,0 +1,124 @@
+#ifndef SEARCH_CONTEXT_HPP
+#define SEARCH_CONTEXT_HPP
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include "indexed-heap.hpp"
+#include "bucket-queue.hpp"
+#include "search-stats.hpp"
+#include "stack.hpp"
+#include "queue.hpp"
+
+/*
+ *	Per-query scratch space for the searches in Maze. Everything a search
+ *	writes lives here (structure-of-arrays, indexed by row*cols+col), so the
+ *	Maze itself is only ever read and one Maze can serve any number of
+ *	concurrent queries as long as each one has its own SearchContext.
+ *
+ *	A context can be reused between queries; the buffers keep their
+ *	capacity so warm queries do not allocate.
+ */
+
+class SearchResult {
+	public:
+		bool        path_found  = false;
+		int         path_length = 0;		// cells strictly between start and goal
+		int         push_count  = 0;
+		[[no_unique_address]] QueryStats stats;	// empty without MAZE_INSTRUMENTATION
+};
+
+// The half of a bidirectional search that grows from the goal. Only the
+// bidirectional searches reset (and therefore allocate) it.
+class BackwardSearch {
+	public:
+		std::vector<int>    parent;	// towards the goal, -1 at the goal
+		std::vector<double> g;		// distance to the goal, -1 if unseen
+		std::vector<bool>   closed;
+		IndexedHeap<double> open;
+
+		void reset(size_t size){
+			parent.assign(size, -1);
+			g.assign(size, -1);
+			closed.assign(size, false);
+			open.reset(size);
+		}
+};
+
+class SearchContext {
+	public:
+		std::vector<int>    parent;	// -1 when the cell has no parent
+		std::vector<double> g;		// -1 when the cell is unexplored
+		std::vector<bool>   closed;	// visited (DFS/BFS) or expanded (A*)
+		std::vector<int>    path;	// start..goal, filled on success
+		IndexedHeap<double> open;	// A*/Dijkstra frontiers, keyed on f.
+		BucketQueue         buckets;	// Reset by the search that uses them.
+		Stack<int>          stack;	// DFS frontier, same.
+		Queue<int>          queue;	// BFS frontier, same.
+		BackwardSearch      backward;	// Same, for bidirectional searches.
+		int                 push_count = 0;
+		[[no_unique_address]] QueryStats stats;	// of the current query
+
+		void reset(size_t size){
+			/*****************************************************************
+			 * @brief Clears the context for a new query on a maze of size
+			 * cells.
+			 * Time Complexity: O(size)
+			 *****************************************************************/
+			parent.assign(size, -1);
+			g.assign(size, -1);
+			closed.assign(size, false);
+			path.clear();
+			push_count = 0;
+			stats      = QueryStats();
+		}
+
+		size_t scratchBytes() const{
+			/*****************************************************************
+			 * @brief Memory held by the per-cell arrays and the path, which
+			 * are most of what a context allocates.
+			 *****************************************************************/
+			return parent.capacity()          * sizeof(int)
+			     + g.capacity()               * sizeof(double)
+			     + closed.capacity() / 8
+			     + path.capacity()            * sizeof(int)
+			     + backward.parent.capacity() * sizeof(int)
+			     + backward.g.capacity()      * sizeof(double)
+			     + backward.closed.capacity() / 8;
+		}
+
+		void record(SearchResult& result){
+			/*****************************************************************
+			 * @brief Copies the statistics of the query that just ended into
+			 * its result. Does nothing without MAZE_INSTRUMENTATION.
+			 *****************************************************************/
+			if constexpr (INSTRUMENTED){
+				stats.finish(result.path_found, scratchBytes());
+				result.stats = stats;
+			}
+		}
+
+		int tracePath(int goal_i){
+			/*****************************************************************
+			 * @brief Follows the parents from goal_i back to the start and
+			 * stores the result, start first, in path.
+			 * @return the path length, not counting start nor goal.
+			 * Time Complexity: O(path length)
+			 *****************************************************************/
+			path.clear();
+			for (int cur_i = goal_i; cur_i != -1; cur_i = parent[cur_i]){
+				path.push_back(cur_i);
+			}
+			std::reverse(path.begin(), path.end());
+			return pathLength();
+		}
+
+		int pathLength() const{
+			/*****************************************************************
+			 * @brief Cells of path strictly between start and goal; 0 when
+			 * the path is just the start, because start == goal.
+			 *****************************************************************/
+			return std::max(static_cast<int>(path.size()) - 2, 0);
+		}
+};
+
+#endif
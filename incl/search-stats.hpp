@@ -0,0 +1,104 @@
+#ifndef SEARCH_STATS_HPP
+#define SEARCH_STATS_HPP
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <algorithm>
+#include <type_traits>
+
+/*
+ *	Per-search instrumentation. Build with MAZE_INSTRUMENTATION defined (the
+ *	CMake option of the same name) to record it. Searches keep their numbers
+ *	in a QueryStats, which is SearchStats with the option and the empty
+ *	NoSearchStats without it. NoSearchStats has the same recording calls as
+ *	empty inline functions and takes no room as a [[no_unique_address]]
+ *	member, and PhaseTimer never reads the clock, so the searches compile
+ *	to the same code as if the calls were not there.
+ *
+ *	A search leaves its numbers in SearchResult::stats. Adding results
+ *	together with += gives the totals for a batch: counters and timings are
+ *	summed, peaks keep the largest value.
+ */
+
+#ifdef MAZE_INSTRUMENTATION
+constexpr bool INSTRUMENTED = true;
+#else
+constexpr bool INSTRUMENTED = false;
+#endif
+
+class NoSearchStats;
+
+class SearchStats {
+	public:
+		enum Phase { SETUP, SEARCH, TRACE, PHASE_COUNT };
+
+		uint64_t queries            = 0;
+		uint64_t found              = 0;
+		uint64_t expanded           = 0;	// cells taken off the frontier and expanded
+		uint64_t pushed             = 0;	// frontier insertions and key updates
+		uint64_t stale_pops         = 0;	// pops skipped as duplicates or outdated
+		uint64_t sift_steps         = 0;	// levels moved by heap sift up/down
+		uint64_t peak_frontier      = 0;	// largest frontier size
+		uint64_t peak_scratch_bytes = 0;	// SearchContext memory in use
+		uint64_t phase_ns[PHASE_COUNT] = {};
+
+		void expand(uint64_t count = 1){ expanded += count; }
+		void stalePop()                { stale_pops += 1; }
+		void sift(uint64_t steps)      { sift_steps += steps; }
+		void push(size_t frontier_size, uint64_t count = 1){
+			pushed       += count;
+			peak_frontier = std::max<uint64_t>(peak_frontier, frontier_size);
+		}
+		void addPhase(Phase phase, uint64_t ns){ phase_ns[phase] += ns; }
+
+		// Called once as the query ends.
+		void finish(bool path_found, uint64_t scratch_bytes){
+			queries            = 1;
+			found              = path_found;
+			peak_scratch_bytes = std::max(peak_scratch_bytes, scratch_bytes);
+		}
+
+		SearchStats& operator+=(const SearchStats& other);
+		SearchStats& operator+=(const NoSearchStats&){ return *this; }
+
+		// One JSON object, or one CSV row matching writeCsvHeader.
+		void        writeJson(std::ostream& out) const;
+		void        writeCsv(std::ostream& out) const;
+		static void writeCsvHeader(std::ostream& out);
+};
+
+// Stands in for SearchStats without MAZE_INSTRUMENTATION.
+class NoSearchStats {
+	public:
+		void expand(uint64_t = 1)            {}
+		void stalePop()                      {}
+		void sift(uint64_t)                  {}
+		void push(size_t, uint64_t = 1)      {}
+		void addPhase(SearchStats::Phase, uint64_t){}
+		void finish(bool, uint64_t)          {}
+};
+
+typedef std::conditional_t<INSTRUMENTED, SearchStats, NoSearchStats> QueryStats;
+
+// Adds the time from construction to destruction to one phase.
+class PhaseTimer {
+	private:
+		QueryStats&                           stats;
+		SearchStats::Phase                    phase;
+		std::chrono::steady_clock::time_point started;
+
+	public:
+		PhaseTimer(QueryStats& stats, SearchStats::Phase phase): stats{stats}, phase{phase}{
+			if constexpr (INSTRUMENTED){ started = std::chrono::steady_clock::now(); }
+		}
+		~PhaseTimer(){
+			if constexpr (INSTRUMENTED){
+				auto elapsed = std::chrono::steady_clock::now() - started;
+				stats.addPhase(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+			}
+		}
+		PhaseTimer(const PhaseTimer&)            = delete;
+		PhaseTimer& operator=(const PhaseTimer&) = delete;
+};
+
+#endif
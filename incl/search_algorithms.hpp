@@ -0,0 +1,318 @@
+#ifndef SEARCH_ALGORITHMS_HPP
+#define SEARCH_ALGORITHMS_HPP
+/*
+ *	This codebase uses javadoc-style banners. If using doxygen, make
+ *	sure to set JAVADOC_BANNER to YES to get the appropriate hinting
+ *	when using it!
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "maze.hpp"
+#include "stack.hpp"
+#include "queue.hpp"
+#include "search-context.hpp"
+#include "indexed-heap.hpp"
+#include "bucket-queue.hpp"
+
+/*
+ *	One grid search, specialised at compile time on four policies:
+ *
+ *	  FrontierT     - which cell is expanded next (stack, queue, heap, buckets)
+ *	  HeuristicT    - estimate of the cost left to the goal
+ *	  ConnectivityT - which neighbors a cell has and what stepping costs
+ *	  VisitT        - when a cell counts as done (when pushed or when popped)
+ *
+ *	Every policy is a plain class whose members are called directly, so each
+ *	combination compiles to its own inlined loop. Maze::dfs, bfs, a_star and
+ *	dijkstra are all instantiations of gridSearch:
+ *
+ *	  dfs      = gridSearch<StackFrontier,  NoHeuristic,        FourConnected, VisitOnPush>
+ *	  bfs      = gridSearch<QueueFrontier,  NoHeuristic,        FourConnected, VisitOnPush>
+ *	  a_star   = gridSearch<HeapFrontier,   ManhattanHeuristic, FourConnected, VisitOnPop>
+ *	  dijkstra = gridSearch<HeapFrontier,   NoHeuristic,        FourConnected, VisitOnPop>
+ */
+
+//////////////////////////////////////////////////////////////////////////////
+// Frontier policies. They are built from the context of the query and give
+// push(cell, f, g), pop(), is_empty() and size().
+
+// The stack and queue live in the context too, so that their buffers are
+// reused from one query to the next.
+class StackFrontier{
+	private:
+		Stack<int>& search_stack;
+	public:
+		StackFrontier(SearchContext& context): search_stack{context.stack}{}
+		void reset(size_t)                       { search_stack.clear(); }
+		void push(int cell_i, double, double)    { search_stack.push(cell_i); }
+		int  pop()                               { return search_stack.pop(); }
+		bool is_empty()                          { return search_stack.isEmpty(); }
+		size_t size()                            { return search_stack.getSize(); }
+};
+
+class QueueFrontier{
+	private:
+		Queue<int>& search_queue;
+	public:
+		QueueFrontier(SearchContext& context): search_queue{context.queue}{}
+		void reset(size_t)                       { search_queue.clear(); }
+		void push(int cell_i, double, double)    { search_queue.push(cell_i); }
+		int  pop()                               { return search_queue.pop(); }
+		bool is_empty()                          { return search_queue.isEmpty(); }
+		size_t size()                            { return search_queue.size(); }
+};
+
+// Uses the indexed heap of the context, so a cell that is reached again
+// with a lower g is moved instead of pushed twice.
+class HeapFrontier{
+	private:
+		IndexedHeap<double>& open;
+	public:
+		HeapFrontier(SearchContext& context): open{context.open}{}
+		void reset(size_t size)                  { open.reset(size); }
+		void push(int cell_i, double f, double)  { open.update(cell_i, f); }
+		int  pop()                               { return open.remove_min().value; }
+		bool is_empty()                          { return open.is_empty(); }
+		size_t size()                            { return open.size(); }
+		size_t siftSteps()                       { return open.siftSteps(); }
+};
+
+// Dial's buckets from the context. Needs integer f and g, so it cannot be
+// used with EightConnected.
+class BucketFrontier{
+	private:
+		BucketQueue& buckets;
+	public:
+		BucketFrontier(SearchContext& context): buckets{context.buckets}{}
+		void reset(size_t size)                  { buckets.reset(size); }
+		void push(int cell_i, double f, double g){
+			buckets.update(cell_i, static_cast<int>(f), static_cast<int>(g));
+		}
+		int  pop()                               { return buckets.remove_min().value; }
+		bool is_empty()                          { return buckets.is_empty(); }
+		size_t size()                            { return buckets.size(); }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// Heuristic policies. Built once per query from the maze and the goal, then
+// called on cell indices, so they may carry state of their own.
+
+class NoHeuristic{
+	public:
+		NoHeuristic(const Maze&, Position){}
+		double operator()(int) const{ return 0.0; }
+};
+
+class ManhattanHeuristic{
+	private:
+		const Maze& maze;
+		Position    goal;
+	public:
+		ManhattanHeuristic(const Maze& maze, Position goal): maze{maze}, goal{goal}{}
+		double operator()(int cell_i) const{
+			return maze.manhattan(maze.toPosition(cell_i), goal);
+		}
+};
+
+// Exact distance on an empty 8-connected grid with diagonal steps of sqrt(2).
+class OctileHeuristic{
+	private:
+		const Maze& maze;
+		Position    goal;
+	public:
+		OctileHeuristic(const Maze& maze, Position goal): maze{maze}, goal{goal}{}
+		double operator()(int cell_i) const{
+			Position pos      = maze.toPosition(cell_i);
+			int      row_diff = std::abs(goal.row - pos.row);
+			int      col_diff = std::abs(goal.col - pos.col);
+			return std::max(row_diff, col_diff) + (M_SQRT2 - 1) * std::min(row_diff, col_diff);
+		}
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// Connectivity policies. forEachNeighbor calls visit(neighbor_i, cost) on
+// every free neighbor of cell_i.
+
+// North, south, west, east. This order decides which of several equal paths
+// DFS and BFS return, so it must stay as it is.
+class FourConnected{
+	public:
+		template<typename Visit>
+		static void forEachNeighbor(const Maze& maze, int cell_i, Visit&& visit){
+			int  cols = maze.getCols();
+			int  rows = maze.getRows();
+			int  row  = cell_i / cols;
+			int  col  = cell_i % cols;
+
+			if (row > 0        && !maze.isBlocked(cell_i - cols)){ visit(cell_i - cols, 1.0); }
+			if (row < rows - 1 && !maze.isBlocked(cell_i + cols)){ visit(cell_i + cols, 1.0); }
+			if (col > 0        && !maze.isBlocked(cell_i - 1))   { visit(cell_i - 1, 1.0); }
+			if (col < cols - 1 && !maze.isBlocked(cell_i + 1))   { visit(cell_i + 1, 1.0); }
+		}
+};
+
+// The four straight moves, then the diagonals at a cost of sqrt(2). A
+// diagonal move may not cut a corner: both cells it passes between must be
+// free. That keeps the cells reachable from a start the same as with
+// FourConnected, so Maze::connected still applies.
+class EightConnected{
+	public:
+		template<typename Visit>
+		static void forEachNeighbor(const Maze& maze, int cell_i, Visit&& visit){
+			FourConnected::forEachNeighbor(maze, cell_i, visit);
+
+			int  cols  = maze.getCols();
+			int  rows  = maze.getRows();
+			int  row   = cell_i / cols;
+			int  col   = cell_i % cols;
+			bool north = row > 0        && !maze.isBlocked(cell_i - cols);
+			bool south = row < rows - 1 && !maze.isBlocked(cell_i + cols);
+			bool west  = col > 0        && !maze.isBlocked(cell_i - 1);
+			bool east  = col < cols - 1 && !maze.isBlocked(cell_i + 1);
+
+			if (north && west && !maze.isBlocked(cell_i - cols - 1)){ visit(cell_i - cols - 1, M_SQRT2); }
+			if (north && east && !maze.isBlocked(cell_i - cols + 1)){ visit(cell_i - cols + 1, M_SQRT2); }
+			if (south && west && !maze.isBlocked(cell_i + cols - 1)){ visit(cell_i + cols - 1, M_SQRT2); }
+			if (south && east && !maze.isBlocked(cell_i + cols + 1)){ visit(cell_i + cols + 1, M_SQRT2); }
+		}
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// Visit policies, using context.closed.
+
+// A cell is final the first time it is reached (DFS, BFS).
+class VisitOnPush{
+	public:
+		static void start(SearchContext& context, int cell_i){ context.closed[cell_i] = true; }
+		static bool expand(SearchContext&, int){ return true; }
+		static bool admit(SearchContext& context, int cell_i, double){
+			if (context.closed[cell_i]){ return false; }
+			context.closed[cell_i] = true;
+			return true;
+		}
+};
+
+// A cell is final once it is popped, and is reached again whenever a lower
+// g is found before that (A*, Dijkstra). A frontier that pushes a cell
+// again instead of moving it may pop it more than once; only the first pop
+// is expanded.
+class VisitOnPop{
+	public:
+		static void start(SearchContext&, int){}
+		static bool expand(SearchContext& context, int cell_i){
+			if (context.closed[cell_i]){ return false; }
+			context.closed[cell_i] = true;
+			return true;
+		}
+		static bool admit(SearchContext& context, int cell_i, double g){
+			if (context.closed[cell_i]){ return false; }
+			return (context.g[cell_i] == -1 || g < context.g[cell_i]);
+		}
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename ConnectivityT, typename VisitT, typename FrontierT, typename HeuristicT>
+int expandNext(
+	const Maze&       maze,
+	SearchContext&    context,
+	FrontierT&        frontier,
+	const HeuristicT& heuristic,
+	int               goal_i){
+	/*****************************************************************
+	 * @brief Pops one cell and pushes the neighbors it improves.
+	 * The goal is popped but not expanded. Shared by gridSearch and *
+	 * slicedSearch, which only differ in when they stop.            *
+	 * @return the cell popped, or -1 if it was a stale pop.
+	 *****************************************************************/
+	QueryStats&  stats  = context.stats;
+	int          cell_i = frontier.pop();
+	if (!VisitT::expand(context, cell_i)){ stats.stalePop(); return -1; }
+	if (cell_i == goal_i){ return cell_i; }
+	stats.expand();
+
+	double cell_g = context.g[cell_i];
+	ConnectivityT::forEachNeighbor(maze, cell_i, [&](int next_i, double cost){
+		double next_g = cell_g + cost;
+		if (!VisitT::admit(context, next_i, next_g)){ return; }
+
+		context.parent[next_i] = cell_i;
+		context.g[next_i]      = next_g;
+		frontier.push(next_i, next_g + heuristic(next_i), next_g);
+		context.push_count += 1;
+		stats.push(frontier.size());
+	});
+	return cell_i;
+}
+
+template<typename FrontierT>
+concept SiftingFrontier = requires(FrontierT frontier){ frontier.siftSteps(); };
+
+template<typename FrontierT, typename HeuristicT, typename ConnectivityT, typename VisitT>
+SearchResult gridSearch(
+	const Maze&       maze,
+	SearchContext&    context,
+	Position          start,
+	Position          goal,
+	const HeuristicT& heuristic){
+	/*****************************************************************
+	 * @brief Searches from start to goal with the given policies.
+	 * Leaves the path in context.path and the search tree in        *
+	 * context.parent/g/closed.                                      *
+	 *****************************************************************/
+	SearchResult result;
+	FrontierT    frontier(context);
+	QueryStats&  stats   = context.stats;
+	int          start_i = maze.toIndex(start);
+	int          goal_i  = maze.toIndex(goal);
+	bool         found   = false;
+
+	{
+		PhaseTimer timer(stats, SearchStats::SETUP);
+		context.reset(maze.getSize());
+		frontier.reset(maze.getSize());
+	}
+	if (!maze.connected(start, goal)){
+		context.record(result);
+		return result;
+	}
+
+	{
+		PhaseTimer timer(stats, SearchStats::SEARCH);
+		context.g[start_i] = 0;
+		VisitT::start(context, start_i);
+		frontier.push(start_i, heuristic(start_i), 0.0);
+
+		while (!frontier.is_empty()){
+			if (expandNext<ConnectivityT, VisitT>(maze, context, frontier, heuristic, goal_i) == goal_i){
+				found = true;
+				break;
+			}
+		}
+	}
+
+	if (found){
+		PhaseTimer timer(stats, SearchStats::TRACE);
+		result.path_found  = true;
+		result.path_length = context.tracePath(goal_i);
+	}
+
+	if constexpr (INSTRUMENTED && SiftingFrontier<FrontierT>){ stats.sift(frontier.siftSteps()); }
+	result.push_count = context.push_count;
+	context.record(result);
+	return result;
+}
+
+template<typename FrontierT, typename HeuristicT, typename ConnectivityT, typename VisitT>
+SearchResult gridSearch(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal){
+	return gridSearch<FrontierT, HeuristicT, ConnectivityT, VisitT>(
+		maze, context, start, goal, HeuristicT(maze, goal));
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef SLICED_SEARCH_HPP
+#define SLICED_SEARCH_HPP
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include "maze.hpp"
+#include "search-context.hpp"
+#include "search_algorithms.hpp"
+
+/*
+ *	Time-sliced searches, for callers with a fixed latency budget per tick.
+ *
+ *	slicedSearch runs the same expansion step as gridSearch (expandNext),
+ *	but as a coroutine: it suspends once the budget of the current slice
+ *	is spent and carries on from the same cell when resumed. Nothing runs
+ *	until the first resume. Between slices, progress() tells how far the
+ *	search got, and progress().closest_i is the expanded cell nearest the
+ *	goal, so context.tracePath(closest_i) gives a partial path to follow
+ *	meanwhile.
+ *
+ *	A task keeps references to the maze and the context it was started
+ *	with. Both must outlive it, the context must not be used by anything
+ *	else and the maze must not be edited until the task is done.
+ *
+ *	SearchScheduler interleaves many such searches on one thread.
+ */
+
+// Limits for one slice. A limit of zero is no limit. The clock is read
+// every CLOCK_STRIDE expansions, so a time limit may be overrun by that
+// many expansions.
+class SliceBudget {
+	public:
+		static constexpr int CLOCK_STRIDE = 16;
+
+		int                       expansions = 0;
+		std::chrono::microseconds time{0};
+};
+
+class SearchProgress {
+	public:
+		int    slices    = 0;	// resumes so far
+		int    expanded  = 0;
+		size_t frontier  = 0;	// cells waiting to be expanded
+		int    closest_i = -1;	// expanded cell with the lowest Manhattan distance to the goal
+};
+
+class SearchTask {
+
+	public:
+		class promise_type {
+			private:
+				SliceBudget                           budget;
+				std::chrono::steady_clock::time_point slice_start;
+				int                                   slice_expansions = 0;
+
+			public:
+				SearchProgress     progress;
+				SearchResult       result;
+				std::exception_ptr error;
+
+				SearchTask get_return_object(){
+					return SearchTask(std::coroutine_handle<promise_type>::from_promise(*this));
+				}
+				std::suspend_always initial_suspend() noexcept{ return {}; }
+				std::suspend_always final_suspend() noexcept  { return {}; }
+				std::suspend_always yield_value(const SearchProgress& current){
+					progress = current;
+					return {};
+				}
+				void return_value(const SearchResult& done){ result = done; }
+				void unhandled_exception()                 { error = std::current_exception(); }
+
+				void startSlice(SliceBudget next){
+					budget           = next;
+					slice_start      = std::chrono::steady_clock::now();
+					slice_expansions = 0;
+				}
+
+				// Called after every expansion.
+				bool sliceSpent(){
+					slice_expansions += 1;
+					if (budget.expansions > 0 && slice_expansions >= budget.expansions){ return true; }
+					if (budget.time.count() == 0 || slice_expansions % SliceBudget::CLOCK_STRIDE != 0){ return false; }
+					return std::chrono::steady_clock::now() - slice_start >= budget.time;
+				}
+		};
+
+		// co_await'ed once by the coroutine to reach its own promise.
+		class Promise {
+			private:
+				promise_type* promise = nullptr;
+			public:
+				bool          await_ready() const noexcept{ return false; }
+				bool          await_suspend(std::coroutine_handle<promise_type> handle) noexcept{
+					promise = &handle.promise();
+					return false;
+				}
+				promise_type& await_resume() const noexcept{ return *promise; }
+		};
+
+	private:
+		std::coroutine_handle<promise_type> handle;
+
+		explicit SearchTask(std::coroutine_handle<promise_type> handle): handle{handle}{}
+
+	public:
+		SearchTask(SearchTask&& other) noexcept: handle{std::exchange(other.handle, nullptr)}{}
+		SearchTask& operator=(SearchTask&& other) noexcept{
+			if (this != &other){
+				if (handle){ handle.destroy(); }
+				handle = std::exchange(other.handle, nullptr);
+			}
+			return *this;
+		}
+		SearchTask(const SearchTask&)            = delete;
+		SearchTask& operator=(const SearchTask&) = delete;
+		~SearchTask(){ if (handle){ handle.destroy(); } }
+
+		bool done() const{ return handle.done(); }
+
+		// Runs one slice. Rethrows what the search threw.
+		// @return whether the search is over
+		bool resume(SliceBudget budget = {}){
+			if (handle.done()){ return true; }
+			handle.promise().startSlice(budget);
+			handle.promise().progress.slices += 1;
+			handle.resume();
+			if (handle.promise().error){ std::rethrow_exception(handle.promise().error); }
+			return handle.done();
+		}
+
+		const SearchProgress& progress() const{ return handle.promise().progress; }
+
+		// Meaningful once done().
+		const SearchResult&   result() const  { return handle.promise().result; }
+};
+
+template<typename FrontierT, typename HeuristicT, typename ConnectivityT, typename VisitT>
+SearchTask slicedSearch(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal,
+	HeuristicT     heuristic){
+	/*****************************************************************
+	 * @brief gridSearch, suspending whenever a slice is spent.
+	 * Same results as gridSearch with the same policies.            *
+	 *****************************************************************/
+	SearchTask::promise_type& slice = co_await SearchTask::Promise{};
+	SearchResult              result;
+	FrontierT                 frontier(context);
+	QueryStats&               stats   = context.stats;
+	int                       start_i = maze.toIndex(start);
+	int                       goal_i  = maze.toIndex(goal);
+	bool                      found   = false;
+	int                       closest = -1;
+
+	context.reset(maze.getSize());
+	frontier.reset(maze.getSize());
+	if (!maze.connected(start, goal)){
+		context.record(result);
+		co_return result;
+	}
+
+	SearchProgress progress = slice.progress;
+	context.g[start_i]      = 0;
+	VisitT::start(context, start_i);
+	frontier.push(start_i, heuristic(start_i), 0.0);
+
+	while (!frontier.is_empty()){
+		int cell_i = expandNext<ConnectivityT, VisitT>(maze, context, frontier, heuristic, goal_i);
+		if (cell_i == goal_i){ found = true; break; }
+		if (cell_i == -1){ continue; }
+
+		int distance = maze.manhattan(maze.toPosition(cell_i), goal);
+		if (progress.closest_i == -1 || distance < closest){
+			progress.closest_i = cell_i;
+			closest            = distance;
+		}
+		progress.expanded += 1;
+		if (slice.sliceSpent()){
+			progress.slices   = slice.progress.slices;
+			progress.frontier = frontier.size();
+			co_yield progress;
+		}
+	}
+
+	if (found){
+		result.path_found  = true;
+		result.path_length = context.tracePath(goal_i);
+	}
+	if constexpr (INSTRUMENTED && SiftingFrontier<FrontierT>){ stats.sift(frontier.siftSteps()); }
+	result.push_count  = context.push_count;
+	progress.slices    = slice.progress.slices;
+	progress.frontier  = 0;
+	slice.progress     = progress;
+	context.record(result);
+	co_return result;
+}
+
+// Sliced counterparts of Maze::dfs, bfs and a_star.
+SearchTask slicedDfs   (const Maze& maze, SearchContext& context, Position start, Position goal);
+SearchTask slicedBfs   (const Maze& maze, SearchContext& context, Position start, Position goal);
+SearchTask slicedAStar (const Maze& maze, SearchContext& context, Position start, Position goal);
+
+class SearchScheduler {
+
+	public:
+		typedef SearchTask (*TaskFunction)(const Maze&, SearchContext&, Position, Position);
+
+	private:
+		class Entry {
+			public:
+				std::unique_ptr<SearchContext> context;
+				SearchTask                     task;
+		};
+
+		const Maze&                                 maze;
+		std::unordered_map<int, Entry>              entries;
+		std::deque<int>                             running;	// round-robin order
+		std::vector<std::unique_ptr<SearchContext>> spare;		// contexts of released tickets
+		int                                         next_ticket = 0;
+
+	public:
+		SearchScheduler(const Maze& maze);
+
+		SearchScheduler(const SearchScheduler&)            = delete;
+		SearchScheduler& operator=(const SearchScheduler&) = delete;
+
+		// Queues a search and returns its ticket. Nothing runs until tick().
+		int submit(Position start, Position goal, TaskFunction search = &slicedAStar);
+
+		// Gives the running searches one slice each, round-robin, and keeps
+		// going around until they are all done or frame has passed. With a
+		// zero frame, every search gets exactly one slice.
+		// @return the number of searches still running
+		size_t tick(SliceBudget slice, std::chrono::microseconds frame = std::chrono::microseconds(0));
+
+		size_t pending() const;
+		bool   isDone(int ticket) const;
+
+		const SearchProgress&   progress(int ticket) const;
+		const SearchResult&     result(int ticket) const;	// once isDone
+		const std::vector<int>& path(int ticket) const;		// once isDone
+
+		// Forgets a ticket, running or not, and keeps its context for reuse.
+		void release(int ticket);
+};
+
+#endif
@@ -21,6 +21,7 @@ class Stack{
 			return return_val;
 		}
 		bool   isEmpty()      {return (data.size() == 0);}
+		void   clear()        {data.clear();}	// keeps the capacity
 
 		std::string toString(){
 			if (this->isEmpty()){return "[EMPTY]";}
@@ -76,7 +77,7 @@ inline std::string Stack<Cell*>::toString(){
 	if (this->isEmpty()){return "[EMPTY]";}
 	std::string result = "+-----+\n";
 	for (int i= this->getSize()-1; i > -1; i--){
-		if (i<this->getSize()-1){ result = result + "---\n";}
+		if (i<int(this->getSize())-1){ result = result + "---\n";}
 		result = result 
 			+ posToString((*data[i]).getPosition())
 			+ "\n";
@@ -0,0 +1,129 @@
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include "../incl/anytime-a-star.hpp"
+#include "../incl/search_algorithms.hpp"
+
+AnytimeAStar::AnytimeAStar(const Maze& maze, SearchContext& context, Position start, Position goal, double epsilon, double step):
+	maze    {maze},
+	tree    {context},
+	start_i {maze.toIndex(start)},
+	goal_i  {maze.toIndex(goal)},
+	epsilon {epsilon},
+	step    {step}{
+	if (epsilon < 1){ throw std::invalid_argument("epsilon must be at least 1"); }
+	if (step <= 0)  { throw std::invalid_argument("step must be positive"); }
+
+	tree.reset(maze.getSize());
+	tree.open.reset(maze.getSize());
+	in_incons.assign(maze.getSize(), false);
+	if (!maze.connected(start, goal)){
+		finished = true;
+		return;
+	}
+	tree.g[start_i] = 0;
+	tree.open.insert(this->key(start_i), start_i);
+}
+
+double AnytimeAStar::heuristic(int cell_i) const{
+	return maze.manhattan(maze.toPosition(cell_i), maze.toPosition(goal_i));
+}
+
+double AnytimeAStar::key(int cell_i) const{
+	return tree.g[cell_i] + epsilon * this->heuristic(cell_i);
+}
+
+void AnytimeAStar::improvePath(){
+	/*************************************************************************
+	 * Expands while some open cell could still lead to a cheaper goal     *
+	 * under the current epsilon. A cell that gets a lower g after being   *
+	 * closed this iteration goes to incons rather than back to open.      *
+	 *************************************************************************/
+	QueryStats& stats = tree.stats;
+	while (!tree.open.is_empty()){
+		if (tree.g[goal_i] != -1 && !(tree.open.min().key < tree.g[goal_i])){ break; }
+
+		int cell_i = tree.open.remove_min().value;
+		tree.closed[cell_i] = true;
+		stats.expand();
+
+		double next_g = tree.g[cell_i] + 1;
+		FourConnected::forEachNeighbor(maze, cell_i, [&](int next_i, double){
+			if (tree.g[next_i] != -1 && !(next_g < tree.g[next_i])){ return; }
+			tree.g[next_i]      = next_g;
+			tree.parent[next_i] = cell_i;
+			tree.push_count    += 1;
+
+			if (!tree.closed[next_i]){
+				tree.open.update(next_i, this->key(next_i));
+				stats.push(tree.open.size());
+			} else if (!in_incons[next_i]){
+				in_incons[next_i] = true;
+				incons.push_back(next_i);
+			}
+		});
+	}
+}
+
+double AnytimeAStar::lowerBound() const{
+	/*************************************************************************
+	 * A lower bound on the unweighted g+h of the open and inconsistent    *
+	 * cells, which every cheaper path than the current one goes through.  *
+	 * Open keys are g + epsilon*h <= epsilon*(g+h), so the smallest key   *
+	 * over epsilon bounds the open cells without scanning them.           *
+	 *************************************************************************/
+	double lowest = std::numeric_limits<double>::infinity();
+	for (int cell_i: incons){ lowest = std::min(lowest, tree.g[cell_i] + this->heuristic(cell_i)); }
+	if (!tree.open.is_empty()){ lowest = std::min(lowest, tree.open.min().key / epsilon); }
+	return lowest;
+}
+
+const AnytimeResult& AnytimeAStar::improve(){
+	/*************************************************************************
+	 * One ARA* iteration: repair the path under epsilon, publish it with  *
+	 * its bound, then lower epsilon and move incons into open with keys   *
+	 * for the new weight.                                                 *
+	 *************************************************************************/
+	if (finished){ return current; }
+
+	this->improvePath();
+	current.iterations += 1;
+	current.epsilon     = epsilon;
+	current.push_count  = tree.push_count;
+	if (tree.g[goal_i] != -1){
+		current.path_found  = true;
+		current.path_length = tree.tracePath(goal_i);
+		// With start == goal both g(goal) and the lower bound are 0, and the
+		// empty path is optimal.
+		double lowest       = this->lowerBound();
+		current.bound       = (tree.g[goal_i] == 0 || lowest <= 0) ? 1.0 : std::clamp(tree.g[goal_i] / lowest, 1.0, epsilon);
+	}
+	if (current.bound == 1 || epsilon == 1 || !current.path_found){ finished = true; }
+	tree.record(current);
+
+	if (!finished){
+		epsilon = std::max(1.0, epsilon - step);
+
+		std::vector<int> open_cells = incons;
+		while (!tree.open.is_empty()){ open_cells.push_back(tree.open.remove_min().value); }
+		for (int cell_i: open_cells){
+			tree.open.update(cell_i, this->key(cell_i));
+			in_incons[cell_i] = false;
+		}
+		incons.clear();
+		tree.closed.assign(maze.getSize(), false);
+	}
+	return current;
+}
+
+bool AnytimeAStar::isDone() const {return finished;}
+
+const AnytimeResult& AnytimeAStar::result() const {return current;}
+
+const AnytimeResult& AnytimeAStar::search(std::chrono::microseconds budget){
+	auto started = std::chrono::steady_clock::now();
+	do {
+		this->improve();
+	} while (!finished && std::chrono::steady_clock::now() - started < budget);
+	return current;
+}
@@ -0,0 +1,94 @@
+#include "../incl/batch-query.hpp"
+
+BatchQueryEngine::BatchQueryEngine
+	(const Maze&   maze
+	,int           worker_count
+	,QueryFunction search
+	)
+	:maze     (maze)
+	,search   (search){
+
+	// hardware_concurrency() is allowed to return 0 when it cannot tell.
+	if (worker_count < 1){ worker_count = 1; }
+
+	contexts.resize(worker_count);
+	for (int worker_i = 0; worker_i < worker_count; worker_i++){
+		workers.emplace_back(&BatchQueryEngine::work, this, worker_i);
+	}
+}
+
+BatchQueryEngine::~BatchQueryEngine(){
+	{
+		std::lock_guard<std::mutex> lock(batch_mutex);
+		stopping = true;
+	}
+	batch_ready.notify_all();
+	for (std::thread& worker: workers){ worker.join(); }
+}
+
+size_t BatchQueryEngine::workerCount() const {return workers.size();}
+
+void BatchQueryEngine::work(int worker_i){
+	/*************************************************************************
+	 * Worker loop. Sleeps until a new batch is posted, then claims queries  *
+	 * one at a time until there are none left.                              *
+	 *************************************************************************/
+	SearchContext& context   = contexts[worker_i];
+	int            seen_batch = 0;
+
+	while (true){
+		{
+			std::unique_lock<std::mutex> lock(batch_mutex);
+			batch_ready.wait(lock, [&]{ return stopping || batch_id != seen_batch; });
+			if (stopping){ return; }
+			seen_batch = batch_id;
+		}
+
+		size_t query_i = next_query.fetch_add(1, std::memory_order_relaxed);
+		while (query_i < queries.size()){
+			const PathQuery& query = queries[query_i];
+			(*results)[query_i] = search(maze, context, query.start, query.goal);
+			query_i = next_query.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(batch_mutex);
+			active_workers -= 1;
+		}
+		batch_done.notify_one();
+	}
+}
+
+std::vector<SearchResult> BatchQueryEngine::run(std::span<const PathQuery> queries){
+	/*************************************************************************
+	 * Posts a batch to the pool and waits until every worker is done with   *
+	 * it. Results come back in the same order as the queries.               *
+	 *************************************************************************/
+	std::vector<SearchResult> batch_results(queries.size());
+	if (queries.empty()){ return batch_results; }
+
+	{
+		std::lock_guard<std::mutex> lock(batch_mutex);
+		this->queries  = queries;
+		this->results  = &batch_results;
+		next_query     = 0;
+		active_workers = workers.size();
+		batch_id      += 1;
+	}
+	batch_ready.notify_all();
+
+	std::unique_lock<std::mutex> lock(batch_mutex);
+	batch_done.wait(lock, [&]{ return active_workers == 0; });
+	this->results = nullptr;
+	return batch_results;
+}
+
+SearchStats BatchQueryEngine::summarize(std::span<const SearchResult> results){
+	/*************************************************************************
+	 * Totals of a batch: counts and timings summed, peaks maxed. All zero   *
+	 * unless built with MAZE_INSTRUMENTATION.                               *
+	 *************************************************************************/
+	SearchStats total;
+	for (const SearchResult& result: results){ total += result.stats; }
+	return total;
+}
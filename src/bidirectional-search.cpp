@@ -0,0 +1,189 @@
+// Bidirectional BFS and A*. One search grows from the start into the
+// context, the other grows from the goal into context.backward, and the path
+// is stitched together through the cell where they meet.
+
+#include <vector>
+#include <limits>
+#include "../incl/maze.hpp"
+#include "../incl/search_algorithms.hpp"
+
+namespace {
+
+	const double NO_PATH = std::numeric_limits<double>::infinity();
+
+	int joinPaths(SearchContext& context, int meet_i){
+		/*********************************************************************
+		 * Builds start..meet from the forward parents, then meet..goal from *
+		 * the backward ones, and rewrites the forward parents along the     *
+		 * second half so that they describe the whole path.                 *
+		 *********************************************************************/
+		context.tracePath(meet_i);
+		for (int cur_i = context.backward.parent[meet_i]; cur_i != -1; cur_i = context.backward.parent[cur_i]){
+			context.parent[cur_i] = context.path.back();
+			context.path.push_back(cur_i);
+		}
+		return context.pathLength();
+	}
+
+}
+
+SearchResult Maze::bidirectional_bfs(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal){
+	/*****************************************************************
+	 * Expands one whole BFS level at a time, always on the side with *
+	 * the smaller frontier. Once a level produces a cell that the    *
+	 * other side has already seen, the best meeting cell of that     *
+	 * level gives a shortest path.                                   *
+	 *****************************************************************/
+	SearchResult    result;
+	BackwardSearch& backward = context.backward;
+	int             start_i  = maze.toIndex(start);
+	int             goal_i   = maze.toIndex(goal);
+
+	context.reset(maze.getSize());
+	backward.reset(maze.getSize());
+	if (!maze.connected(start, goal)){
+		context.record(result);
+		return result;
+	}
+
+	std::vector<int> forward_level  = {start_i};
+	std::vector<int> backward_level = {goal_i};
+	std::vector<int> next_level;
+	context.g[start_i] = 0;
+	backward.g[goal_i] = 0;
+
+	// The two sides already meet when start == goal.
+	double best_length = (start_i == goal_i) ? 0       : NO_PATH;
+	int    meet_i      = (start_i == goal_i) ? start_i : -1;
+
+	while (!forward_level.empty() && !backward_level.empty() && meet_i == -1){
+		bool                 go_forward = forward_level.size() <= backward_level.size();
+		std::vector<int>&    level      = go_forward ? forward_level : backward_level;
+		std::vector<double>& own_g      = go_forward ? context.g      : backward.g;
+		std::vector<int>&    own_parent = go_forward ? context.parent : backward.parent;
+		std::vector<double>& other_g    = go_forward ? backward.g     : context.g;
+
+		next_level.clear();
+		for (int cell_i: level){
+			context.stats.expand();
+			FourConnected::forEachNeighbor(maze, cell_i, [&](int next_i, double){
+				if (own_g[next_i] != -1){ return; }
+				own_g[next_i]      = own_g[cell_i] + 1;
+				own_parent[next_i] = cell_i;
+				next_level.push_back(next_i);
+				context.push_count += 1;
+				context.stats.push(forward_level.size() + backward_level.size() + next_level.size());
+
+				if (other_g[next_i] != -1 && own_g[next_i] + other_g[next_i] < best_length){
+					best_length = own_g[next_i] + other_g[next_i];
+					meet_i      = next_i;
+				}
+			});
+		}
+		level.swap(next_level);
+	}
+
+	if (meet_i != -1){
+		result.path_found  = true;
+		result.path_length = joinPaths(context, meet_i);
+	}
+	result.push_count = context.push_count;
+	context.record(result);
+	return result;
+}
+
+SearchResult Maze::bidirectional_a_star(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal){
+	/*****************************************************************
+	 * Two A* searches, towards the goal and towards the start, each  *
+	 * with its own Manhattan heuristic. The side with the smaller    *
+	 * top f is expanded next. Every time one side reaches a cell the *
+	 * other has seen, the best known path (mu) may improve. The      *
+	 * search stops when either top f reaches mu, since both are      *
+	 * lower bounds on any path not found yet.                        *
+	 *****************************************************************/
+	SearchResult    result;
+	BackwardSearch& backward = context.backward;
+	int             start_i  = maze.toIndex(start);
+	int             goal_i   = maze.toIndex(goal);
+
+	context.reset(maze.getSize());
+	context.open.reset(maze.getSize());
+	backward.reset(maze.getSize());
+	if (!maze.connected(start, goal)){
+		context.record(result);
+		return result;
+	}
+
+	context.g[start_i] = 0;
+	backward.g[goal_i] = 0;
+	context.open.insert(maze.manhattan(start, goal), start_i);
+	backward.open.insert(maze.manhattan(goal, start), goal_i);
+
+	// The two sides already meet when start == goal.
+	double best_length = (start_i == goal_i) ? 0       : NO_PATH;
+	int    meet_i      = (start_i == goal_i) ? start_i : -1;
+
+	while (!context.open.is_empty() && !backward.open.is_empty()){
+		double forward_top  = context.open.min().key;
+		double backward_top = backward.open.min().key;
+		if (forward_top >= best_length || backward_top >= best_length){ break; }
+
+		bool                 go_forward = forward_top <= backward_top;
+		IndexedHeap<double>& open       = go_forward ? context.open   : backward.open;
+		std::vector<double>& own_g      = go_forward ? context.g      : backward.g;
+		std::vector<int>&    own_parent = go_forward ? context.parent : backward.parent;
+		std::vector<bool>&   own_closed = go_forward ? context.closed : backward.closed;
+		std::vector<double>& other_g    = go_forward ? backward.g     : context.g;
+		Position             target     = go_forward ? goal           : start;
+
+		int cell_i = open.remove_min().value;
+		own_closed[cell_i] = true;
+		context.stats.expand();
+
+		FourConnected::forEachNeighbor(maze, cell_i, [&](int next_i, double cost){
+			if (own_closed[next_i]){ return; }
+			double updated_g = own_g[cell_i] + cost;
+			if (own_g[next_i] != -1 && !(updated_g < own_g[next_i])){ return; }
+
+			own_g[next_i]      = updated_g;
+			own_parent[next_i] = cell_i;
+			open.update(next_i, updated_g + maze.manhattan(maze.toPosition(next_i), target));
+			context.push_count += 1;
+			context.stats.push(context.open.size() + backward.open.size());
+
+			if (other_g[next_i] != -1 && updated_g + other_g[next_i] < best_length){
+				best_length = updated_g + other_g[next_i];
+				meet_i      = next_i;
+			}
+		});
+	}
+
+	if (meet_i != -1){
+		result.path_found  = true;
+		result.path_length = joinPaths(context, meet_i);
+	}
+	context.stats.sift(context.open.siftSteps() + backward.open.siftSteps());
+	result.push_count = context.push_count;
+	context.record(result);
+	return result;
+}
+
+std::optional<Cell*> Maze::bidirectional_bfs(Maze* maze){
+	maze->resetStats();
+	SearchResult result = Maze::bidirectional_bfs(*maze, maze->last_search, maze->start, maze->goal);
+	return maze->updatePath(result);
+}
+
+std::optional<Cell*> Maze::bidirectional_a_star(Maze* maze){
+	maze->resetStats();
+	SearchResult result = Maze::bidirectional_a_star(*maze, maze->last_search, maze->start, maze->goal);
+	return maze->updatePath(result);
+}
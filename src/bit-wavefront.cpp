@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <bit>
+#include "../incl/bit-wavefront.hpp"
+
+namespace {
+
+	// Occluded fills: spreads the bits of seeds along the runs of open they
+	// sit in, towards the high or the low end of the word.
+	uint64_t fillHigh(uint64_t seeds, uint64_t open){
+		seeds &= open;
+		seeds |= open & (seeds << 1);  open &= open << 1;
+		seeds |= open & (seeds << 2);  open &= open << 2;
+		seeds |= open & (seeds << 4);  open &= open << 4;
+		seeds |= open & (seeds << 8);  open &= open << 8;
+		seeds |= open & (seeds << 16); open &= open << 16;
+		seeds |= open & (seeds << 32);
+		return seeds;
+	}
+
+	uint64_t fillLow(uint64_t seeds, uint64_t open){
+		seeds &= open;
+		seeds |= open & (seeds >> 1);  open &= open >> 1;
+		seeds |= open & (seeds >> 2);  open &= open >> 2;
+		seeds |= open & (seeds >> 4);  open &= open >> 4;
+		seeds |= open & (seeds >> 8);  open &= open >> 8;
+		seeds |= open & (seeds >> 16); open &= open >> 16;
+		seeds |= open & (seeds >> 32);
+		return seeds;
+	}
+
+	// Grows the seeds of one row to the whole runs of free cells they are
+	// in: one pass carrying runs up across word boundaries, one down.
+	void fillRuns(uint64_t* seeds, const uint64_t* open, size_t row_words){
+		uint64_t carry = 0;
+		for (size_t word_i = 0; word_i < row_words; word_i++){
+			seeds[word_i] = fillHigh(seeds[word_i] | carry, open[word_i]);
+			carry         = seeds[word_i] >> 63;
+		}
+		carry = 0;
+		for (size_t word_i = row_words; word_i-- > 0; ){
+			seeds[word_i] = fillLow(seeds[word_i] | (carry << 63), open[word_i]);
+			carry         = seeds[word_i] & 1;
+		}
+	}
+
+
+	// One BFS step on one row: the frontier bits of cur shifted left and
+	// right, carrying across words, or'ed with the rows above and below and
+	// masked by open & ~visited. The first and last words have only one
+	// neighbor word, so they are done outside the loop, which leaves the
+	// loop over the words in between without branches for the vectorizer.
+	uint64_t growRow(
+		const uint64_t* cur,
+		const uint64_t* up,
+		const uint64_t* down,
+		const uint64_t* open,
+		uint64_t*       visited,
+		uint64_t*       out,
+		size_t          row_words){
+		auto grow = [&](size_t word_i, uint64_t from_left, uint64_t from_right){
+			uint64_t grown   = (from_left | from_right | up[word_i] | down[word_i]) & open[word_i] & ~visited[word_i];
+			out[word_i]      = grown;
+			visited[word_i] |= grown;
+			return grown;
+		};
+
+		size_t last_i = row_words - 1;
+		if (last_i == 0){ return grow(0, cur[0] << 1, cur[0] >> 1); }
+
+		uint64_t any = grow(0, cur[0] << 1, (cur[0] >> 1) | (cur[1] << 63));
+		for (size_t word_i = 1; word_i < last_i; word_i++){
+			any |= grow(word_i,
+				(cur[word_i] << 1) | (cur[word_i-1] >> 63),
+				(cur[word_i] >> 1) | (cur[word_i+1] << 63));
+		}
+		any |= grow(last_i, (cur[last_i] << 1) | (cur[last_i-1] >> 63), cur[last_i] >> 1);
+		return any;
+	}
+
+}
+
+BitGrid::BitGrid(size_t rows, size_t cols):
+	rows      {rows},
+	cols      {cols},
+	row_words {(cols + 63) / 64},
+	words     (rows * row_words, 0){}
+
+void BitGrid::set(size_t row, size_t col, bool value){
+	uint64_t& word = words[row*row_words + col/64];
+	uint64_t  bit  = uint64_t(1) << (col%64);
+	word = value ? (word | bit) : (word & ~bit);
+}
+
+void BitGrid::clear(){
+	std::fill(words.begin(), words.end(), 0);
+}
+
+size_t BitGrid::count() const{
+	size_t total = 0;
+	for (uint64_t word: words){ total += std::popcount(word); }
+	return total;
+}
+
+BitWavefront::BitWavefront(const Maze& maze):
+	maze       {maze},
+	free_cells (maze.getRows(), maze.getCols()),
+	seen       (maze.getRows(), maze.getCols()),
+	frontier   (maze.getRows(), maze.getCols()),
+	next       (maze.getRows(), maze.getCols()),
+	seen_edits {maze.getEdits().size()}{
+	for (int cell_i = 0; cell_i < maze.getSize(); cell_i++){
+		Position pos = maze.toPosition(cell_i);
+		free_cells.set(pos.row, pos.col, !maze.isBlocked(cell_i));
+	}
+}
+
+void BitWavefront::refresh(){
+	/*************************************************************************
+	 * Brings the free mask up to date with the cells edited since the    *
+	 * last flood.                                                          *
+	 *************************************************************************/
+	const std::vector<int>& edits = maze.getEdits();
+	for (; seen_edits < edits.size(); seen_edits++){
+		int      cell_i = edits[seen_edits];
+		Position pos    = maze.toPosition(cell_i);
+		free_cells.set(pos.row, pos.col, !maze.isBlocked(cell_i));
+	}
+}
+
+template<typename OnLayer>
+int BitWavefront::flood(int source_i, int target_i, OnLayer on_layer){
+	/*************************************************************************
+	 * Level-synchronous BFS a word at a time. Only rows within one step of *
+	 * the current frontier are visited, and the frontier rows are zeroed   *
+	 * again once used so both buffers stay clear outside [low, high].      *
+	 *************************************************************************/
+	this->refresh();
+	seen.clear();
+	frontier.clear();
+	next.clear();
+
+	Position source = maze.toPosition(source_i);
+	if (!free_cells.test(source.row, source.col)){ return -1; }
+
+	size_t row_words = free_cells.getRowWords();
+	size_t rows      = free_cells.getRows();
+	seen.set(source.row, source.col, true);
+	frontier.set(source.row, source.col, true);
+	on_layer(0, source.row, frontier.row(source.row));
+	if (source_i == target_i){ return 0; }
+
+	Position target = (target_i == -1) ? Position(0,0) : maze.toPosition(target_i);
+	size_t   low    = source.row;
+	size_t   high   = source.row;
+
+	for (int distance = 1; ; distance++){
+		size_t first    = (low == 0) ? 0 : low - 1;
+		size_t last     = std::min(high + 1, rows - 1);
+		size_t new_low  = rows;
+		size_t new_high = 0;
+
+		for (size_t row_i = first; row_i <= last; row_i++){
+			uint64_t any = growRow(
+				frontier.row(row_i),
+				frontier.row(row_i > 0 ? row_i - 1 : row_i),
+				frontier.row(row_i + 1 < rows ? row_i + 1 : row_i),
+				free_cells.row(row_i),
+				seen.row(row_i),
+				next.row(row_i),
+				row_words);
+			if (any == 0){ continue; }
+			new_low  = std::min(new_low, row_i);
+			new_high = row_i;
+			on_layer(distance, row_i, next.row(row_i));
+		}
+
+		for (size_t row_i = low; row_i <= high; row_i++){
+			std::fill(frontier.row(row_i), frontier.row(row_i) + row_words, 0);
+		}
+		std::swap(frontier, next);
+
+		if (new_low == rows){ return (target_i == -1) ? distance - 1 : -1; }
+		if (target_i != -1 && seen.test(target.row, target.col)){ return distance; }
+		low  = new_low;
+		high = new_high;
+	}
+}
+
+int BitWavefront::distance(Position from, Position to){
+	return this->flood(maze.toIndex(from), maze.toIndex(to), [](int, size_t, const uint64_t*){});
+}
+
+std::vector<int> BitWavefront::distanceField(Position source){
+	std::vector<int> field(maze.getSize(), -1);
+	size_t row_words = free_cells.getRowWords();
+	size_t cols      = free_cells.getCols();
+
+	this->flood(maze.toIndex(source), -1, [&](int distance, size_t row_i, const uint64_t* layer){
+		for (size_t word_i = 0; word_i < row_words; word_i++){
+			for (uint64_t bits = layer[word_i]; bits != 0; bits &= bits - 1){
+				field[row_i*cols + word_i*64 + std::countr_zero(bits)] = distance;
+			}
+		}
+	});
+	return field;
+}
+
+const BitGrid& BitWavefront::reachable(Position source){
+	/*************************************************************************
+	 * Sweeps down and then up the rows, seeding each row from its          *
+	 * neighbor and filling the runs the seeds touch, until a pair of       *
+	 * sweeps adds nothing.                                                 *
+	 *************************************************************************/
+	this->refresh();
+	seen.clear();
+	if (!free_cells.test(source.row, source.col)){ return seen; }
+
+	size_t row_words = free_cells.getRowWords();
+	int    rows      = free_cells.getRows();
+	seen.set(source.row, source.col, true);
+	fillRuns(seen.row(source.row), free_cells.row(source.row), row_words);
+
+	auto spread = [&](int from_i, int to_i){
+		const uint64_t* from = seen.row(from_i);
+		const uint64_t* open = free_cells.row(to_i);
+		uint64_t*       to   = seen.row(to_i);
+		uint64_t        any  = 0;
+		for (size_t word_i = 0; word_i < row_words; word_i++){
+			uint64_t added = from[word_i] & open[word_i] & ~to[word_i];
+			to[word_i] |= added;
+			any        |= added;
+		}
+		if (any != 0){ fillRuns(to, open, row_words); }
+		return any != 0;
+	};
+
+	bool changed = true;
+	while (changed){
+		changed = false;
+		for (int row_i = 1; row_i < rows; row_i++)      { changed |= spread(row_i - 1, row_i); }
+		for (int row_i = rows - 2; row_i >= 0; row_i--){ changed |= spread(row_i + 1, row_i); }
+	}
+	return seen;
+}
+
+const BitGrid& BitWavefront::reached() const{
+	return seen;
+}
@@ -4,23 +4,19 @@
 
 Cell::Cell(Position position, Contents contents):
 	position 	{position}, 
-	contents 	{contents},
-	parent 		{nullptr}{}
+	contents 	{contents}{}
 
 Cell::Cell(Contents contents):
 	position 	{-1,-1}, 
-	contents 	{contents},
-	parent 		{nullptr}{}
+	contents 	{contents}{}
 
 Cell::Cell():
 	position 	{-1,-1}, 
-	contents 	{Contents::UNINT},
-	parent 		{nullptr}{
+	contents 	{Contents::UNINT}{
 }
 
-Position Cell::getPosition()              {return position;}
-Contents Cell::getContents()              {return contents;}
-Cell*    Cell::getParent()                {return parent;}
+Position Cell::getPosition() const        {return position;}
+Contents Cell::getContents() const        {return contents;}
 
 std::string posToString(Position pos){
 	std::string return_string = std::string("");	
@@ -35,17 +31,13 @@ std::string posToString(Position pos){
 }
 
 void	 Cell::setPosition(int row, int col){position = Position(row,col);}
-void     Cell::setContents(Contents contents){contents = contents;};
+void     Cell::setContents(Contents contents){this->contents = contents;};
 
-bool     Cell::isBlocked()                {return contents == Contents::BLOCKED;}
-bool     Cell::isGoal()                   {return contents == Contents::GOAL;}
+bool     Cell::isBlocked() const          {return contents == Contents::BLOCKED;}
+bool     Cell::isGoal() const             {return contents == Contents::GOAL;}
 
 void     Cell::markOnPath()	              {contents = Contents::PATH;}
 void     Cell::markAsBlocked()            {contents = Contents::BLOCKED;}
-void     Cell::setParent(Cell& parent_cell){
-	Cell* new_ptr = &parent_cell;
-	this->parent = new_ptr;
-}
 
 std::string	Cell::toString() {
 	std::string str_contents = std::string(1, static_cast<char>(contents));
@@ -56,12 +48,6 @@ bool Cell::operator==(Cell other) {
 	return (
 		(position.col 	== other.getPosition().col) &&
 		(position.row 	== other.getPosition().row) &&
-		(contents 		== other.getContents()) 	&&
-		(parent 		== other.getParent())
+		(contents 		== other.getContents())
 	);
 }
-
-int Cell::toInt(){
-	Position pos = this->getPosition();
-	return(pos.row*10+pos.col);
-}
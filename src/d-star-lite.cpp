@@ -0,0 +1,174 @@
+// D* Lite, following the optimised version in Koenig & Likhachev,
+// "D* Lite" (AAAI 2002), figure 4.
+
+#include <limits>
+#include <algorithm>
+#include "../incl/d-star-lite.hpp"
+
+namespace {
+	const double INF = std::numeric_limits<double>::infinity();
+}
+
+DStarLite::DStarLite(const Maze& maze, Position start, Position goal):
+	maze         {maze},
+	start_i      {maze.toIndex(start)},
+	goal_i       {maze.toIndex(goal)},
+	last_start_i {maze.toIndex(start)},
+	g            (maze.getSize(), INF),
+	rhs          (maze.getSize(), INF),
+	open         (maze.getSize()),
+	seen_edits   {maze.getEdits().size()}{
+
+	rhs[goal_i] = 0;
+	open.insert(Key(heuristic(start_i, goal_i), 0), goal_i);
+}
+
+double DStarLite::heuristic(int from_i, int to_i) const{
+	return maze.manhattan(maze.toPosition(from_i), maze.toPosition(to_i));
+}
+
+DStarLite::Key DStarLite::calculateKey(int cell_i) const{
+	double best = std::min(g[cell_i], rhs[cell_i]);
+	return Key(best + heuristic(start_i, cell_i) + km, best);
+}
+
+double DStarLite::cost(int from_i, int to_i) const{
+	if (maze.isBlocked(from_i) || maze.isBlocked(to_i)){ return INF; }
+	return 1;
+}
+
+int DStarLite::neighbors(int cell_i, int (&out)[4]) const{
+	/*************************************************************************
+	 * Writes the in-bounds neighbors of cell_i into out, blocked or not,   *
+	 * since a blocked neighbor still needs its rhs updated.                *
+	 *************************************************************************/
+	Position pos   = maze.toPosition(cell_i);
+	int      count = 0;
+	int      cols  = maze.getCols();
+	if (pos.row > 0)                  { out[count++] = cell_i - cols; }
+	if (pos.row < maze.getRows() - 1) { out[count++] = cell_i + cols; }
+	if (pos.col > 0)                  { out[count++] = cell_i - 1; }
+	if (pos.col < cols - 1)           { out[count++] = cell_i + 1; }
+	return count;
+}
+
+void DStarLite::updateVertex(int cell_i, SearchContext& context){
+	if (cell_i != goal_i){
+		int    next[4];
+		int    count = neighbors(cell_i, next);
+		double best  = INF;
+		for (int i = 0; i < count; i++){
+			best = std::min(best, cost(cell_i, next[i]) + g[next[i]]);
+		}
+		rhs[cell_i] = best;
+	}
+
+	if (g[cell_i] != rhs[cell_i]){
+		open.update(cell_i, calculateKey(cell_i));
+		context.push_count += 1;
+		context.stats.push(open.size());
+	} else {
+		open.remove(cell_i);
+	}
+}
+
+void DStarLite::computeShortestPath(SearchContext& context){
+	/*************************************************************************
+	 * Expands inconsistent cells until the start is consistent and nothing *
+	 * in the open list could still improve it.                             *
+	 *************************************************************************/
+	while (!open.is_empty()
+			&& (open.min().key < calculateKey(start_i) || rhs[start_i] != g[start_i])){
+
+		Entry<Key,int> top     = open.min();
+		int            cell_i  = top.value;
+		Key            new_key = calculateKey(cell_i);
+		int            next[4];
+		int            count   = neighbors(cell_i, next);
+
+		if (top.key < new_key){
+			open.update(cell_i, new_key);
+			context.stats.stalePop();
+		} else if (g[cell_i] > rhs[cell_i]){
+			g[cell_i] = rhs[cell_i];
+			open.remove(cell_i);
+			context.stats.expand();
+			for (int i = 0; i < count; i++){ updateVertex(next[i], context); }
+		} else {
+			g[cell_i] = INF;
+			context.stats.expand();
+			for (int i = 0; i < count; i++){ updateVertex(next[i], context); }
+			updateVertex(cell_i, context);
+		}
+	}
+}
+
+void DStarLite::moveStart(Position start){
+	start_i = maze.toIndex(start);
+}
+
+double DStarLite::distanceToGoal(Position pos) const{
+	return g[maze.toIndex(pos)];
+}
+
+SearchResult DStarLite::replan(SearchContext& context){
+	SearchResult result;
+	context.path.clear();
+	context.push_count = 0;
+	context.stats      = QueryStats();
+
+	// Heuristics are measured from the start; km keeps the old keys valid
+	// lower bounds after the start moved instead of re-keying the whole
+	// open list.
+	km           += heuristic(last_start_i, start_i);
+	last_start_i  = start_i;
+
+	const std::vector<int>& edits = maze.getEdits();
+	int next[4];
+	for (; seen_edits < edits.size(); seen_edits++){
+		int cell_i = edits[seen_edits];
+		int count  = neighbors(cell_i, next);
+		updateVertex(cell_i, context);
+		for (int i = 0; i < count; i++){ updateVertex(next[i], context); }
+	}
+
+	// Without a path the search would empty the whole open list. The tree
+	// stays valid if it is not run, so the next replan picks it up again.
+	if (!maze.connected(maze.toPosition(start_i), maze.toPosition(goal_i))){
+		result.push_count = context.push_count;
+		context.record(result);
+		return result;
+	}
+	computeShortestPath(context);
+
+	result.push_count = context.push_count;
+	if (g[start_i] == INF){
+		context.record(result);
+		return result;
+	}
+
+	// Walk down the g-values towards the goal.
+	context.path.push_back(start_i);
+	int cell_i = start_i;
+	while (cell_i != goal_i){
+		int    count   = neighbors(cell_i, next);
+		int    best_i  = -1;
+		double best    = INF;
+		for (int i = 0; i < count; i++){
+			double through = cost(cell_i, next[i]) + g[next[i]];
+			if (through < best){ best = through; best_i = next[i]; }
+		}
+		if (best_i == -1){
+			context.path.clear();
+			context.record(result);
+			return result;
+		}
+		cell_i = best_i;
+		context.path.push_back(cell_i);
+	}
+
+	result.path_found  = true;
+	result.path_length = context.pathLength();
+	context.record(result);
+	return result;
+}
@@ -0,0 +1,147 @@
+#include <array>
+#include <utility>
+#include <algorithm>
+#include "../incl/flow-field.hpp"
+
+FlowField::FlowField(const Maze& maze, Position goal):
+	maze      {maze},
+	goal_i    {maze.toIndex(goal)},
+	distance  (maze.getSize(), UNREACHABLE),
+	direction (maze.getSize(), NONE){
+	/*************************************************************************
+	 * One BFS out of the goal. A cell found from its neighbor above points *
+	 * UP, and so on, so the directions are set as cells are discovered.    *
+	 *************************************************************************/
+	if (maze.isBlocked(goal_i)){ return; }
+	int              rows = maze.getRows();
+	int              cols = maze.getCols();
+	std::vector<int> queue;
+	queue.reserve(maze.getSize());
+	queue.push_back(goal_i);
+	distance[goal_i] = 0;
+
+	for (size_t head = 0; head < queue.size(); head++){
+		int cell_i = queue[head];
+		int row    = cell_i / cols;
+		int col    = cell_i % cols;
+		std::array<std::pair<int, Direction>, 4> neighbors = {{
+			{(row > 0)        ? cell_i - cols : -1, DOWN},
+			{(row < rows - 1) ? cell_i + cols : -1, UP},
+			{(col > 0)        ? cell_i - 1    : -1, RIGHT},
+			{(col < cols - 1) ? cell_i + 1    : -1, LEFT}
+		}};
+		for (auto [next_i, back]: neighbors){
+			if (next_i == -1 || distance[next_i] != UNREACHABLE || maze.isBlocked(next_i)){ continue; }
+			distance[next_i]  = std::min<int>(distance[cell_i] + 1, MAX_DISTANCE);
+			direction[next_i] = back;
+			queue.push_back(next_i);
+		}
+	}
+}
+
+int FlowField::nextStep(int cell_i) const{
+	switch (direction[cell_i]){
+		case UP:    return cell_i - maze.getCols();
+		case DOWN:  return cell_i + maze.getCols();
+		case LEFT:  return cell_i - 1;
+		case RIGHT: return cell_i + 1;
+		default:    return -1;
+	}
+}
+
+bool FlowField::touches(int cell_i) const{
+	/*************************************************************************
+	 * Blocking a cell only matters if it was reachable; freeing one only  *
+	 * matters if it joins a reachable neighbor. Either way the cell or a  *
+	 * neighbor has a distance. The goal is the exception: a field built   *
+	 * while it was blocked has no distances at all.                       *
+	 *************************************************************************/
+	if (cell_i == goal_i){ return true; }
+	int rows = maze.getRows();
+	int cols = maze.getCols();
+	int row  = cell_i / cols;
+	int col  = cell_i % cols;
+	std::array<int, 5> cells = {
+		cell_i,
+		(row > 0)        ? cell_i - cols : -1,
+		(row < rows - 1) ? cell_i + cols : -1,
+		(col > 0)        ? cell_i - 1    : -1,
+		(col < cols - 1) ? cell_i + 1    : -1
+	};
+	for (int near_i: cells){
+		if (near_i != -1 && distance[near_i] != UNREACHABLE){ return true; }
+	}
+	return false;
+}
+
+SearchResult FlowField::search(SearchContext& context, Position start) const{
+	SearchResult result;
+	int          start_i = maze.toIndex(start);
+	context.path.clear();
+	context.push_count = 0;
+	context.stats      = QueryStats();
+	if (distance[start_i] == UNREACHABLE){
+		context.record(result);
+		return result;
+	}
+
+	for (int cell_i = start_i; cell_i != -1; cell_i = this->nextStep(cell_i)){
+		context.path.push_back(cell_i);
+		context.push_count += 1;
+		context.stats.push(1);
+		context.stats.expand();
+	}
+	result.path_found  = true;
+	result.path_length = context.pathLength();
+	result.push_count  = context.push_count;
+	context.record(result);
+	return result;
+}
+
+FlowFieldCache::FlowFieldCache(const Maze& maze, size_t capacity):
+	maze       {maze},
+	capacity   {std::max<size_t>(capacity, 1)},
+	seen_edits {maze.getEdits().size()}{}
+
+size_t FlowFieldCache::size() const {return fields.size();}
+
+void FlowFieldCache::refresh(){
+	/*************************************************************************
+	 * Drops every cached field that an edit since the last call touches.  *
+	 *************************************************************************/
+	const std::vector<int>& edits = maze.getEdits();
+	if (seen_edits == edits.size()){ return; }
+
+	for (auto field_it = fields.begin(); field_it != fields.end(); ){
+		bool stale = false;
+		for (size_t edit_i = seen_edits; edit_i < edits.size() && !stale; edit_i++){
+			stale = (*field_it)->touches(edits[edit_i]);
+		}
+		if (!stale){ ++field_it; continue; }
+		by_goal.erase((*field_it)->getGoal());
+		field_it = fields.erase(field_it);
+	}
+	seen_edits = edits.size();
+}
+
+std::shared_ptr<const FlowField> FlowFieldCache::field(Position goal){
+	this->refresh();
+	int  goal_i = maze.toIndex(goal);
+	auto found  = by_goal.find(goal_i);
+	if (found != by_goal.end()){
+		fields.splice(fields.begin(), fields, found->second);
+		return fields.front();
+	}
+
+	if (fields.size() == capacity){
+		by_goal.erase(fields.back()->getGoal());
+		fields.pop_back();
+	}
+	fields.push_front(std::make_shared<const FlowField>(maze, goal));
+	by_goal[goal_i] = fields.begin();
+	return fields.front();
+}
+
+SearchResult FlowFieldCache::search(SearchContext& context, Position start, Position goal){
+	return this->field(goal)->search(context, start);
+}
@@ -0,0 +1,85 @@
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../incl/grid-storage.hpp"
+
+MappedFile::MappedFile(const std::string& path){
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file == -1){ throw std::runtime_error("Cannot open " + path); }
+
+	struct stat info;
+	if (::fstat(file, &info) == -1){
+		::close(file);
+		throw std::runtime_error("Cannot stat " + path);
+	}
+	size = info.st_size;
+
+	// Empty files cannot be mapped; the loader rejects them on size anyway.
+	if (size > 0){
+		void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+		if (mapped == MAP_FAILED){
+			::close(file);
+			throw std::runtime_error("Cannot map " + path);
+		}
+		base = static_cast<std::byte*>(mapped);
+	}
+	// The mapping stays valid after the descriptor is closed.
+	::close(file);
+}
+
+MappedFile::~MappedFile(){
+	if (base != nullptr){ ::munmap(base, size); }
+}
+
+GridStorage::GridStorage(std::vector<Contents>&& cells):
+	owned {std::move(cells)},
+	cells {owned.data()},
+	count {owned.size()}{}
+
+GridStorage::GridStorage(const GridStorage& other):
+	owned {other.cells, other.cells + other.count},
+	cells {owned.data()},
+	count {other.count}{}
+
+GridStorage::GridStorage(GridStorage&& other):
+	owned   {std::move(other.owned)},
+	mapping {std::move(other.mapping)},
+	cells   {other.cells},
+	count   {other.count}{
+
+	other.cells = nullptr;
+	other.count = 0;
+}
+
+GridStorage& GridStorage::operator=(GridStorage other){
+	std::swap(owned,   other.owned);
+	std::swap(mapping, other.mapping);
+	std::swap(cells,   other.cells);
+	std::swap(count,   other.count);
+	return *this;
+}
+
+GridStorage GridStorage::view(std::shared_ptr<MappedFile> mapping, size_t offset, size_t count){
+	if (offset > mapping->bytes() || count > mapping->bytes() - offset){
+		throw std::invalid_argument("Cell array does not fit in the file");
+	}
+	GridStorage storage;
+	storage.cells   = reinterpret_cast<Contents*>(mapping->data() + offset);
+	storage.count   = count;
+	storage.mapping = std::move(mapping);
+	return storage;
+}
+
+void GridStorage::resize(size_t size){
+	if (mapping != nullptr){
+		owned.assign(cells, cells + std::min(size, count));
+		mapping.reset();
+	}
+	owned.resize(size);
+	cells = owned.data();
+	count = size;
+}
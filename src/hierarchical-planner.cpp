@@ -0,0 +1,385 @@
+// HPA* after Botea, Müller & Schaeffer, "Near Optimal Hierarchical
+// Path-Finding" (2004).
+
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+#include "../incl/hierarchical-planner.hpp"
+
+namespace {
+	// Border runs at least this wide get an entrance at each end instead of
+	// a single one in the middle.
+	const int WIDE_ENTRANCE = 6;
+}
+
+HierarchicalPlanner::HierarchicalPlanner(const Maze& maze, int cluster_size):
+	maze         {maze},
+	cluster_size {cluster_size}{
+
+	if (cluster_size < 2){ throw std::invalid_argument("Clusters must be at least 2x2"); }
+
+	cluster_rows = (maze.getRows() + cluster_size - 1) / cluster_size;
+	cluster_cols = (maze.getCols() + cluster_size - 1) / cluster_size;
+	local_dist.resize(cluster_size*cluster_size);
+	local_parent.resize(cluster_size*cluster_size);
+	local_queue.reserve(cluster_size*cluster_size);
+
+	clusters.resize(cluster_rows*cluster_cols);
+	for (int cluster_k = 0; cluster_k < clusters.size(); cluster_k++){
+		Cluster& cluster = clusters[cluster_k];
+		cluster.row0 = (cluster_k / cluster_cols) * cluster_size;
+		cluster.col0 = (cluster_k % cluster_cols) * cluster_size;
+		cluster.rows = std::min<int>(cluster_size, maze.getRows() - cluster.row0);
+		cluster.cols = std::min<int>(cluster_size, maze.getCols() - cluster.col0);
+	}
+	for (int cluster_k = 0; cluster_k < clusters.size(); cluster_k++){ buildCluster(cluster_k); }
+	for (int cluster_k = 0; cluster_k < clusters.size(); cluster_k++){ linkPartners(cluster_k); }
+	numberNodes();
+	seen_edits = maze.getEdits().size();
+}
+
+int HierarchicalPlanner::clusterCount() const  {return clusters.size();}
+int HierarchicalPlanner::entranceCount() const {return entrance_slot.size();}
+int HierarchicalPlanner::buildCount() const    {return build_count;}
+
+int HierarchicalPlanner::clusterOf(int cell_i) const{
+	Position pos = maze.toPosition(cell_i);
+	return (pos.row / cluster_size) * cluster_cols + (pos.col / cluster_size);
+}
+
+int HierarchicalPlanner::localOffset(const Cluster& cluster, int cell_i) const{
+	Position pos = maze.toPosition(cell_i);
+	return (pos.row - cluster.row0) * cluster_size + (pos.col - cluster.col0);
+}
+
+void HierarchicalPlanner::borderTransitions(
+	int                               cluster_k,
+	int                               neighbor_k,
+	std::vector<std::pair<int,int>>&  transitions) const{
+	/*************************************************************************
+	 * Appends the (inside, outside) cell pairs where an entrance crosses    *
+	 * the border between two side-by-side clusters. The runs are scanned   *
+	 * the same way from both sides, so both clusters agree on them.        *
+	 *************************************************************************/
+	const Cluster& cluster  = clusters[cluster_k];
+	const Cluster& neighbor = clusters[neighbor_k];
+	int cols = maze.getCols();
+
+	// Border cells on either side, walked in increasing row/col order.
+	int length;
+	std::array<int, 2> first;	// first cell inside, first cell outside
+	int step;
+	if (cluster.row0 == neighbor.row0){
+		length = cluster.rows;
+		step   = cols;
+		int inside_col  = cluster.col0 < neighbor.col0 ? cluster.col0 + cluster.cols - 1 : cluster.col0;
+		int outside_col = cluster.col0 < neighbor.col0 ? neighbor.col0 : neighbor.col0 + neighbor.cols - 1;
+		first = {cluster.row0*cols + inside_col, cluster.row0*cols + outside_col};
+	} else {
+		length = cluster.cols;
+		step   = 1;
+		int inside_row  = cluster.row0 < neighbor.row0 ? cluster.row0 + cluster.rows - 1 : cluster.row0;
+		int outside_row = cluster.row0 < neighbor.row0 ? neighbor.row0 : neighbor.row0 + neighbor.rows - 1;
+		first = {inside_row*cols + cluster.col0, outside_row*cols + cluster.col0};
+	}
+
+	int run_start = -1;
+	for (int i = 0; i <= length; i++){
+		bool is_open = i < length
+			&& !maze.isBlocked(first[0] + i*step)
+			&& !maze.isBlocked(first[1] + i*step);
+		if (is_open && run_start == -1){ run_start = i; }
+		if (is_open || run_start == -1){ continue; }
+
+		int run_end = i-1;
+		if (run_end - run_start + 1 >= WIDE_ENTRANCE){
+			transitions.push_back({first[0] + run_start*step, first[1] + run_start*step});
+			transitions.push_back({first[0] + run_end*step,   first[1] + run_end*step});
+		} else {
+			int middle = (run_start + run_end) / 2;
+			transitions.push_back({first[0] + middle*step, first[1] + middle*step});
+		}
+		run_start = -1;
+	}
+}
+
+void HierarchicalPlanner::clusterBfs(int cluster_k, int from_i){
+	/*************************************************************************
+	 * Fills local_dist/local_parent with a BFS from from_i that never       *
+	 * leaves the cluster. -1 marks cells that cannot be reached.            *
+	 *************************************************************************/
+	const Cluster& cluster = clusters[cluster_k];
+	int cols = maze.getCols();
+
+	std::fill(local_dist.begin(), local_dist.end(), -1);
+	local_queue.clear();
+
+	int from_offset = localOffset(cluster, from_i);
+	local_dist[from_offset]   = 0;
+	local_parent[from_offset] = -1;
+	local_queue.push_back(from_i);
+
+	for (int head = 0; head < local_queue.size(); head++){
+		int      cell_i = local_queue[head];
+		Position pos    = maze.toPosition(cell_i);
+		int      dist   = local_dist[localOffset(cluster, cell_i)];
+
+		std::array<Position, 4> directions = {
+			Position(pos.row-1, pos.col), Position(pos.row+1, pos.col),
+			Position(pos.row, pos.col-1), Position(pos.row, pos.col+1)
+		};
+		for (Position next: directions){
+			if (next.row < cluster.row0 || next.row >= cluster.row0 + cluster.rows){ continue; }
+			if (next.col < cluster.col0 || next.col >= cluster.col0 + cluster.cols){ continue; }
+			int next_i      = next.row*cols + next.col;
+			int next_offset = localOffset(cluster, next_i);
+			if (maze.isBlocked(next_i) || local_dist[next_offset] != -1){ continue; }
+			local_dist[next_offset]   = dist + 1;
+			local_parent[next_offset] = cell_i;
+			local_queue.push_back(next_i);
+		}
+	}
+}
+
+void HierarchicalPlanner::buildCluster(int cluster_k){
+	/*************************************************************************
+	 * Recomputes the entrances of a cluster from its four borders and the  *
+	 * distances between them.                                              *
+	 *************************************************************************/
+	Cluster& cluster = clusters[cluster_k];
+	for (int cell_i: cluster.entrances){ entrance_slot.erase(cell_i); }
+	cluster.entrances.clear();
+	cluster.partners.clear();
+
+	int cluster_row = cluster_k / cluster_cols;
+	int cluster_col = cluster_k % cluster_cols;
+	std::vector<std::pair<int,int>> transitions;
+	if (cluster_row > 0)               { borderTransitions(cluster_k, cluster_k - cluster_cols, transitions); }
+	if (cluster_row < cluster_rows - 1){ borderTransitions(cluster_k, cluster_k + cluster_cols, transitions); }
+	if (cluster_col > 0)               { borderTransitions(cluster_k, cluster_k - 1, transitions); }
+	if (cluster_col < cluster_cols - 1){ borderTransitions(cluster_k, cluster_k + 1, transitions); }
+
+	for (auto [inside_i, outside_i]: transitions){
+		auto found = entrance_slot.find(inside_i);
+		int  slot;
+		if (found == entrance_slot.end()){
+			slot = cluster.entrances.size();
+			entrance_slot[inside_i] = slot;
+			cluster.entrances.push_back(inside_i);
+			cluster.partners.push_back({});
+		} else {
+			slot = found->second;
+		}
+		cluster.partners[slot].push_back(outside_i);
+	}
+
+	int count = cluster.entrances.size();
+	cluster.distances.assign(count*count, -1);
+	for (int from = 0; from < count; from++){
+		clusterBfs(cluster_k, cluster.entrances[from]);
+		for (int to = 0; to < count; to++){
+			cluster.distances[from*count + to] = local_dist[localOffset(cluster, cluster.entrances[to])];
+		}
+	}
+	build_count += 1;
+}
+
+void HierarchicalPlanner::linkPartners(int cluster_k){
+	/*************************************************************************
+	 * Looks up the slot of every partner in its own cluster, so that the   *
+	 * search can step across a border without going through the map.      *
+	 *************************************************************************/
+	Cluster& cluster = clusters[cluster_k];
+	cluster.partner_slots.resize(cluster.partners.size());
+	for (int slot = 0; slot < cluster.partners.size(); slot++){
+		cluster.partner_slots[slot].clear();
+		for (int partner_i: cluster.partners[slot]){ cluster.partner_slots[slot].push_back(entrance_slot.at(partner_i)); }
+	}
+}
+
+void HierarchicalPlanner::numberNodes(){
+	/*************************************************************************
+	 * Gives the entrances dense node ids, cluster by cluster.              *
+	 *************************************************************************/
+	first_node.resize(clusters.size());
+	node_count = 0;
+	for (int cluster_k = 0; cluster_k < clusters.size(); cluster_k++){
+		first_node[cluster_k] = node_count;
+		node_count           += clusters[cluster_k].entrances.size();
+	}
+}
+
+int HierarchicalPlanner::entranceDistance(int cluster_k, int from_slot, int to_slot) const{
+	const Cluster& cluster = clusters[cluster_k];
+	return cluster.distances[from_slot*cluster.entrances.size() + to_slot];
+}
+
+void HierarchicalPlanner::refresh(){
+	/*************************************************************************
+	 * Rebuilds every cluster holding an edited cell, and the neighbors of   *
+	 * that cluster when the cell sits on their shared border.               *
+	 *************************************************************************/
+	const std::vector<int>& edits = maze.getEdits();
+	if (seen_edits == edits.size()){ return; }
+
+	std::unordered_set<int> dirty;
+	for (; seen_edits < edits.size(); seen_edits++){
+		int      cell_i    = edits[seen_edits];
+		int      cluster_k = clusterOf(cell_i);
+		Position pos       = maze.toPosition(cell_i);
+		const Cluster& cluster = clusters[cluster_k];
+		dirty.insert(cluster_k);
+
+		if (pos.row == cluster.row0 && pos.row > 0)                             { dirty.insert(cluster_k - cluster_cols); }
+		if (pos.row == cluster.row0 + cluster.rows - 1 && pos.row < maze.getRows() - 1){ dirty.insert(cluster_k + cluster_cols); }
+		if (pos.col == cluster.col0 && pos.col > 0)                             { dirty.insert(cluster_k - 1); }
+		if (pos.col == cluster.col0 + cluster.cols - 1 && pos.col < maze.getCols() - 1){ dirty.insert(cluster_k + 1); }
+	}
+	for (int cluster_k: dirty){ buildCluster(cluster_k); }
+
+	// Partners pointing into a rebuilt cluster may have new slots.
+	std::unordered_set<int> relink = dirty;
+	for (int cluster_k: dirty){
+		int cluster_row = cluster_k / cluster_cols;
+		int cluster_col = cluster_k % cluster_cols;
+		if (cluster_row > 0)               { relink.insert(cluster_k - cluster_cols); }
+		if (cluster_row < cluster_rows - 1){ relink.insert(cluster_k + cluster_cols); }
+		if (cluster_col > 0)               { relink.insert(cluster_k - 1); }
+		if (cluster_col < cluster_cols - 1){ relink.insert(cluster_k + 1); }
+	}
+	for (int cluster_k: relink){ linkPartners(cluster_k); }
+	numberNodes();
+}
+
+void HierarchicalPlanner::refineSegment(int from_i, int to_i, std::vector<int>& path){
+	/*************************************************************************
+	 * Appends the cells after from_i up to to_i. Cells in different        *
+	 * clusters are neighbors across a border; otherwise a BFS inside the   *
+	 * cluster finds the cells in between.                                  *
+	 *************************************************************************/
+	int cluster_k = clusterOf(from_i);
+	if (cluster_k != clusterOf(to_i)){ path.push_back(to_i); return; }
+
+	const Cluster& cluster = clusters[cluster_k];
+	clusterBfs(cluster_k, from_i);
+	size_t first = path.size();
+	for (int cur_i = to_i; cur_i != from_i; cur_i = local_parent[localOffset(cluster, cur_i)]){
+		path.push_back(cur_i);
+	}
+	std::reverse(path.begin() + first, path.end());
+}
+
+SearchResult HierarchicalPlanner::search(SearchContext& context, Position start, Position goal){
+	/*************************************************************************
+	 * A* over the entrances. The start is linked to the entrances of its   *
+	 * cluster and the entrances of the goal's cluster are linked to the    *
+	 * goal, using BFS distances inside those two clusters only.            *
+	 *************************************************************************/
+	this->refresh();
+
+	SearchResult result;
+	context.path.clear();
+	context.push_count = 0;
+	context.stats      = QueryStats();
+
+	int start_i       = maze.toIndex(start);
+	int goal_i        = maze.toIndex(goal);
+	int start_cluster = clusterOf(start_i);
+	int goal_cluster  = clusterOf(goal_i);
+	if (!maze.connected(start, goal)){
+		context.record(result);
+		return result;
+	}
+
+	// Distances from the start and to the goal within their clusters.
+	std::vector<int> from_start(clusters[start_cluster].entrances.size());
+	std::vector<int> to_goal(clusters[goal_cluster].entrances.size());
+	int direct = -1;
+
+	clusterBfs(start_cluster, start_i);
+	for (int slot = 0; slot < from_start.size(); slot++){
+		from_start[slot] = local_dist[localOffset(clusters[start_cluster], clusters[start_cluster].entrances[slot])];
+	}
+	if (start_cluster == goal_cluster){ direct = local_dist[localOffset(clusters[goal_cluster], goal_i)]; }
+
+	clusterBfs(goal_cluster, goal_i);
+	for (int slot = 0; slot < to_goal.size(); slot++){
+		to_goal[slot] = local_dist[localOffset(clusters[goal_cluster], clusters[goal_cluster].entrances[slot])];
+	}
+
+	// Abstract A* over dense node ids. Slot s of cluster k is node
+	// first_node[k] + s; the start and the goal come after the entrances,
+	// and the start links to its own entrance, if it is one, at cost 0.
+	int start_node = node_count;
+	int goal_node  = node_count + 1;
+	node_g.assign(node_count + 2, -1);
+	node_parent.assign(node_count + 2, -1);
+	node_closed.assign(node_count + 2, false);
+	node_cell.resize(node_count + 2);
+	node_open.reset(node_count + 2);
+
+	auto relax = [&](int from, int to, int to_i, int cost){
+		if (cost < 0 || node_closed[to]){ return; }
+		double updated_g = node_g[from] + cost;
+		if (node_g[to] != -1 && !(updated_g < node_g[to])){ return; }
+		node_g[to]      = updated_g;
+		node_parent[to] = from;
+		node_cell[to]   = to_i;
+		node_open.update(to, updated_g + maze.manhattan(maze.toPosition(to_i), goal));
+		context.push_count += 1;
+		context.stats.push(node_open.size());
+	};
+
+	node_g[start_node]    = 0;
+	node_cell[start_node] = start_i;
+	node_open.insert(maze.manhattan(start, goal), start_node);
+
+	while (!node_open.is_empty()){
+		int node = node_open.remove_min().value;
+		node_closed[node] = true;
+		if (node == goal_node){ result.path_found = true; break; }
+		context.stats.expand();
+
+		if (node == start_node){
+			const Cluster& cluster = clusters[start_cluster];
+			for (int slot = 0; slot < cluster.entrances.size(); slot++){
+				relax(start_node, first_node[start_cluster] + slot, cluster.entrances[slot], from_start[slot]);
+			}
+			relax(start_node, goal_node, goal_i, direct);
+			continue;
+		}
+
+		int            cluster_k = clusterOf(node_cell[node]);
+		int            slot      = node - first_node[cluster_k];
+		const Cluster& cluster   = clusters[cluster_k];
+		for (int other = 0; other < cluster.entrances.size(); other++){
+			if (other != slot){ relax(node, first_node[cluster_k] + other, cluster.entrances[other], entranceDistance(cluster_k, slot, other)); }
+		}
+		for (int partner = 0; partner < cluster.partners[slot].size(); partner++){
+			int partner_i = cluster.partners[slot][partner];
+			relax(node, first_node[clusterOf(partner_i)] + cluster.partner_slots[slot][partner], partner_i, 1);
+		}
+		if (cluster_k == goal_cluster){ relax(node, goal_node, goal_i, to_goal[slot]); }
+	}
+	context.stats.sift(node_open.siftSteps());
+
+	if (!result.path_found){
+		context.record(result);
+		return result;
+	}
+
+	// Refine the abstract path, one cluster-sized segment at a time.
+	std::vector<int> abstract_path;
+	for (int node = goal_node; node != -1; node = node_parent[node]){ abstract_path.push_back(node_cell[node]); }
+	std::reverse(abstract_path.begin(), abstract_path.end());
+
+	context.path.push_back(start_i);
+	for (int i = 1; i < abstract_path.size(); i++){
+		refineSegment(abstract_path[i-1], abstract_path[i], context.path);
+	}
+	result.path_length = context.pathLength();
+	result.push_count  = context.push_count;
+	context.record(result);
+	return result;
+}
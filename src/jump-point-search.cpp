@@ -0,0 +1,191 @@
+// Jump Point Search for a 4-connected grid with unit costs.
+//
+// Straight runs of cells that cannot branch into a shorter path are skipped
+// over by jump(), so only the cells where the path may need to turn (jump
+// points) are ever pushed into the open list. The pruning rules are the
+// 4-connected ones (no diagonal moves):
+//
+// 		https://harablog.wordpress.com/2011/09/07/jump-point-search/
+// 		https://github.com/qiao/PathFinding.js (JPFNeverMoveDiagonally)
+
+#include <array>
+#include "../incl/maze.hpp"
+
+namespace {
+
+	class Jumper {
+		/*********************************************************************
+		 * Read-only helper around the maze for one JPS query              *
+		 *********************************************************************/
+		public:
+			const Maze& maze;
+			int         rows;
+			int         cols;
+			int         goal_i;
+
+			Jumper(const Maze& maze, int goal_i):
+				maze   {maze},
+				rows   {static_cast<int>(maze.getRows())},
+				cols   {static_cast<int>(maze.getCols())},
+				goal_i {goal_i}{}
+
+			bool isWalkable(int row, int col) const{
+				if (row < 0 || col < 0 || row >= rows || col >= cols){ return false; }
+				return !maze.isBlocked(row*cols + col);
+			}
+
+			int jumpHorizontal(int row, int col, int d_col) const{
+				/*************************************************************
+				 * Walks along a row. Returns the first jump point, or -1   *
+				 * when it runs into a wall.                                *
+				 *************************************************************/
+				while (isWalkable(row, col)){
+					int cell_i = row*cols + col;
+					if (cell_i == goal_i){ return cell_i; }
+
+					bool forced_up   = isWalkable(row-1, col) && !isWalkable(row-1, col-d_col);
+					bool forced_down = isWalkable(row+1, col) && !isWalkable(row+1, col-d_col);
+					if (forced_up || forced_down){ return cell_i; }
+
+					col += d_col;
+				}
+				return -1;
+			}
+
+			int jumpVertical(int row, int col, int d_row) const{
+				/*************************************************************
+				 * Walks along a column. Any cell from which a horizontal   *
+				 * jump finds something is a jump point as well.            *
+				 *************************************************************/
+				while (isWalkable(row, col)){
+					int cell_i = row*cols + col;
+					if (cell_i == goal_i){ return cell_i; }
+
+					bool forced_left  = isWalkable(row, col-1) && !isWalkable(row-d_row, col-1);
+					bool forced_right = isWalkable(row, col+1) && !isWalkable(row-d_row, col+1);
+					if (forced_left || forced_right){ return cell_i; }
+
+					if (jumpHorizontal(row, col+1,  1) != -1){ return cell_i; }
+					if (jumpHorizontal(row, col-1, -1) != -1){ return cell_i; }
+
+					row += d_row;
+				}
+				return -1;
+			}
+
+			int jump(int row, int col, int d_row, int d_col) const{
+				if (d_col != 0){ return jumpHorizontal(row, col, d_col); }
+				return jumpVertical(row, col, d_row);
+			}
+	};
+
+	int sign(int x){ return (x > 0) - (x < 0); }
+
+}
+
+SearchResult Maze::jps(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal){
+	/*****************************************************************
+	 * A* over jump points. g-costs between two jump points are the  *
+	 * Manhattan distance since they always share a row or column.   *
+	 * The parents in the context link jump points; the full path is *
+	 * filled in between them once the goal is reached.              *
+	 *****************************************************************/
+	SearchResult         result;
+	int                  goal_i = maze.toIndex(goal);
+	Jumper               jumper(maze, goal_i);
+	IndexedHeap<double>& to_explore = context.open;
+
+	context.reset(maze.getSize());
+	to_explore.reset(maze.getSize());
+	if (!maze.connected(start, goal)){
+		context.record(result);
+		return result;
+	}
+
+	int start_i = maze.toIndex(start);
+	context.g[start_i] = 0;
+	to_explore.insert(maze.manhattan(start, goal), start_i);
+
+	while (!to_explore.is_empty()){
+		int n_i = to_explore.remove_min().value;
+		context.closed[n_i] = true;
+
+		if (n_i == goal_i){
+			result.path_found = true;
+			break;
+		}
+		context.stats.expand();
+
+		Position n_pos = maze.toPosition(n_i);
+
+		// Directions worth trying from here. Without a parent all four are;
+		// otherwise keep going straight and try both sides.
+		std::array<Position, 4> directions;
+		int direction_count = 0;
+		if (context.parent[n_i] == -1){
+			directions      = {Position(-1,0), Position(1,0), Position(0,-1), Position(0,1)};
+			direction_count = 4;
+		} else {
+			Position p_pos = maze.toPosition(context.parent[n_i]);
+			int      d_row = sign(n_pos.row - p_pos.row);
+			int      d_col = sign(n_pos.col - p_pos.col);
+			if (d_col != 0){
+				directions = {Position(-1,0), Position(1,0), Position(0,d_col), Position(0,0)};
+			} else {
+				directions = {Position(0,-1), Position(0,1), Position(d_row,0), Position(0,0)};
+			}
+			direction_count = 3;
+		}
+
+		for (int i = 0; i < direction_count; i++){
+			Position d      = directions[i];
+			int      jump_i = jumper.jump(n_pos.row + d.row, n_pos.col + d.col, d.row, d.col);
+			if (jump_i == -1 || context.closed[jump_i]){ continue; }
+
+			Position jump_pos  = maze.toPosition(jump_i);
+			double   updated_g = context.g[n_i] + maze.manhattan(n_pos, jump_pos);
+			if (context.g[jump_i] != -1 && !(updated_g < context.g[jump_i])){ continue; }
+
+			context.g[jump_i]      = updated_g;
+			context.parent[jump_i] = n_i;
+			to_explore.update(jump_i, updated_g + maze.manhattan(jump_pos, goal));
+			context.push_count += 1;
+			context.stats.push(to_explore.size());
+		}
+	}
+
+	if (result.path_found){
+		// Fill in the straight segments between consecutive jump points.
+		context.tracePath(goal_i);
+		std::vector<int> jump_points;
+		jump_points.swap(context.path);
+		context.path.push_back(jump_points.front());
+		for (int i = 1; i < jump_points.size(); i++){
+			Position from  = maze.toPosition(jump_points[i-1]);
+			Position to    = maze.toPosition(jump_points[i]);
+			int      d_row = sign(to.row - from.row);
+			int      d_col = sign(to.col - from.col);
+			while (from.row != to.row || from.col != to.col){
+				from = Position(from.row + d_row, from.col + d_col);
+				context.parent[maze.toIndex(from)] = context.path.back();
+				context.path.push_back(maze.toIndex(from));
+			}
+		}
+		result.path_length = context.pathLength();
+	}
+
+	context.stats.sift(to_explore.siftSteps());
+	result.push_count = context.push_count;
+	context.record(result);
+	return result;
+}
+
+std::optional<Cell*> Maze::jps(Maze* maze){
+	maze->resetStats();
+	SearchResult result = Maze::jps(*maze, maze->last_search, maze->start, maze->goal);
+	return maze->updatePath(result);
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include "../incl/landmarks.hpp"
+#include "../incl/bit-wavefront.hpp"
+#include "../incl/search_algorithms.hpp"
+
+Landmarks::Landmarks(const Maze& maze, Unbuilt):
+	maze       {maze},
+	seen_edits {maze.getEdits().size()}{}
+
+Landmarks::Landmarks(const Maze& maze, int count):
+	Landmarks(maze, Unbuilt()){
+	requested = count;
+	this->build(count);
+}
+
+void Landmarks::build(int count){
+	/*************************************************************************
+	 * Farthest-point placement: the first landmark is the cell farthest   *
+	 * from a cell of the largest component, and each next one is the cell *
+	 * whose distance to its closest landmark is largest. Every landmark's *
+	 * BFS goes straight into its column of the table.                     *
+	 *************************************************************************/
+	BitWavefront wavefront(maze);
+	size_t       size = maze.getSize();
+
+	// A cell of the largest component, or the first free cell when the maze
+	// has no labels.
+	int seed_i = -1;
+	if (maze.hasComponents()){
+		int largest = 0;
+		for (int label = 1; label < maze.labelBound(); label++){
+			if (maze.componentSize(label) > maze.componentSize(largest)){ largest = label; }
+		}
+		for (int cell_i = 0; cell_i < size && seed_i == -1; cell_i++){
+			if (maze.componentOf(maze.toPosition(cell_i)) == largest){ seed_i = cell_i; }
+		}
+	} else {
+		for (int cell_i = 0; cell_i < size && seed_i == -1; cell_i++){
+			if (!maze.isBlocked(cell_i)){ seed_i = cell_i; }
+		}
+	}
+
+	cells.clear();
+	owned.clear();
+	mapping.reset();
+	table      = nullptr;
+	seen_edits = maze.getEdits().size();
+	if (seed_i == -1 || count < 1){ return; }
+
+	std::vector<int> closest = wavefront.distanceField(maze.toPosition(seed_i));
+	std::vector<std::vector<int>> fields;
+	for (int landmark_k = 0; landmark_k < count; landmark_k++){
+		int farthest_i = std::max_element(closest.begin(), closest.end()) - closest.begin();
+		if (closest[farthest_i] <= 0){ break; }		// every reachable cell is a landmark already
+		cells.push_back(farthest_i);
+		fields.push_back(wavefront.distanceField(maze.toPosition(farthest_i)));
+		for (int cell_i = 0; cell_i < size; cell_i++){
+			if (landmark_k == 0){ closest[cell_i] = fields.back()[cell_i]; }
+			else                { closest[cell_i] = std::min(closest[cell_i], fields.back()[cell_i]); }
+		}
+	}
+
+	owned.resize(size * cells.size());
+	for (int cell_i = 0; cell_i < size; cell_i++){
+		for (int landmark_k = 0; landmark_k < cells.size(); landmark_k++){
+			int distance = fields[landmark_k][cell_i];
+			owned[cell_i*cells.size() + landmark_k] = (distance == -1) ? UNREACHABLE : std::min(distance, UNREACHABLE - 1);
+		}
+	}
+	table = owned.data();
+}
+
+void Landmarks::refresh(){
+	if (seen_edits == maze.getEdits().size()){ return; }
+	this->build(requested);
+}
+
+SearchResult Landmarks::search(SearchContext& context, Position start, Position goal){
+	this->refresh();
+	return gridSearch<HeapFrontier, LandmarkHeuristic, FourConnected, VisitOnPop>(
+		maze, context, start, goal, LandmarkHeuristic(maze, *this, goal));
+}
+
+LandmarkHeuristic::LandmarkHeuristic(const Maze& maze, const Landmarks& landmarks, Position goal):
+	maze      {maze},
+	landmarks {landmarks},
+	goal      {goal},
+	to_goal   (landmarks.count()){
+	for (int landmark_k = 0; landmark_k < landmarks.count(); landmark_k++){
+		to_goal[landmark_k] = landmarks.distance(landmark_k, maze.toIndex(goal));
+	}
+}
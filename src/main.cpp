@@ -4,6 +4,7 @@
 // 		https://en.cppreference.com/w/cpp/chrono/steady_clock/now
 
 #include "../incl/maze.hpp"
+#include "../incl/batch-query.hpp"
 #include <iostream>
 #include <chrono>
 #include <random>
@@ -50,6 +51,15 @@ class Stats {
 				unreachable_count += 1;
 			}
 		}
+
+		void update(SearchResult result){
+			if (result.path_found){
+				total_pushes      += result.push_count;
+				total_path_length += result.path_length;
+			} else {
+				unreachable_count += 1;
+			}
+		}
 };
 
 
@@ -66,6 +76,9 @@ void benchmarkAlgorithm(
 	Stats dfs_stats;
 	Stats bfs_stats;
 	Stats a_stats;
+	Stats jps_stats;
+	Stats bi_bfs_stats;
+	Stats bi_a_stats;
 
 	for (int i: std::views::iota(0,TRIALS)){
 		std::mt19937 rng(i);
@@ -112,6 +125,33 @@ void benchmarkAlgorithm(
 		std::cout << "a_star version: \n" << maze.toString() << "\n";
 
 		maze.resetStats();
+
+		start       = std::chrono::steady_clock::now();
+		Maze::jps(&maze);
+		end         = std::chrono::steady_clock::now();
+		it_duration = end-start;
+		jps_stats.update(maze, it_duration);
+		std::cout << "jps version: \n" << maze.toString() << "\n";
+
+		maze.resetStats();
+
+		start       = std::chrono::steady_clock::now();
+		Maze::bidirectional_bfs(&maze);
+		end         = std::chrono::steady_clock::now();
+		it_duration = end-start;
+		bi_bfs_stats.update(maze, it_duration);
+		std::cout << "bidirectional bfs version: \n" << maze.toString() << "\n";
+
+		maze.resetStats();
+
+		start       = std::chrono::steady_clock::now();
+		Maze::bidirectional_a_star(&maze);
+		end         = std::chrono::steady_clock::now();
+		it_duration = end-start;
+		bi_a_stats.update(maze, it_duration);
+		std::cout << "bidirectional a_star version: \n" << maze.toString() << "\n";
+
+		maze.resetStats();
 	}
 	std::cout << "DFS Benchmark: \n";
 	dfs_stats.print();
@@ -119,6 +159,60 @@ void benchmarkAlgorithm(
 	bfs_stats.print();
 	std::cout << "A Star Benchmark: \n";
 	a_stats.print();
+	std::cout << "JPS Benchmark: \n";
+	jps_stats.print();
+	std::cout << "Bidirectional BFS Benchmark: \n";
+	bi_bfs_stats.print();
+	std::cout << "Bidirectional A Star Benchmark: \n";
+	bi_a_stats.print();
+}
+
+
+void benchmarkBatch(
+		int                    rows, 
+		int                    cols,
+		float                  proportion,
+		int                    query_count,
+		int                    max_workers){
+	/*************************************************************************
+	 * Answers the same batch of random queries on a single maze with the    *
+	 * BatchQueryEngine, doubling the number of workers each round, and      *
+	 * reports the throughput of each round.                                 *
+	 *************************************************************************/
+
+	Maze maze = Maze(Position(0,0), Position(rows-1, cols-1), rows, cols, 0, proportion);
+
+	std::mt19937 rng(0);
+	std::vector<PathQuery> queries;
+	while (queries.size() < query_count){
+		Position start_pos(rng() % rows, rng() % cols);
+		Position end_pos(rng() % rows, rng() % cols);
+		if (maze.isBlocked(maze.toIndex(start_pos))){continue;}
+		if (maze.isBlocked(maze.toIndex(end_pos)))  {continue;}
+		queries.push_back(PathQuery(start_pos, end_pos));
+	}
+
+	for (int workers = 1; workers <= max_workers; workers *= 2){
+		BatchQueryEngine engine(maze, workers);
+		Stats batch_stats;
+
+		auto start   = std::chrono::steady_clock::now();
+		std::vector<SearchResult> results = engine.run(queries);
+		auto end     = std::chrono::steady_clock::now();
+		Duration it_duration = end-start;
+
+		for (SearchResult& result: results){batch_stats.update(result);}
+
+		std::cout
+			<< "Batch of " << query_count << " A* queries with "
+			<< workers << " workers: \n        "
+			<< "Queries per second  : "
+			<< query_count/it_duration.count()
+			<< "\n        "
+			<< "Unreachable queries : "
+			<< batch_stats.unreachable_count
+			<< "\n";
+	}
 }
 
 
@@ -144,4 +238,6 @@ int main(){
 
 	benchmarkAlgorithm(30, 30, .25);
 
+	benchmarkBatch(200, 200, .25, 2000, std::max(1u, std::thread::hardware_concurrency()));
+
 }
@@ -0,0 +1,157 @@
+// Binary maze files. See Maze::save in incl/maze.hpp for the layout.
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include "../incl/maze.hpp"
+#include "../incl/grid-storage.hpp"
+#include "../incl/landmarks.hpp"
+
+namespace {
+
+	const char     MAGIC[8]     = {'A','M','A','Z','E','B','I','N'};
+	const uint32_t VERSION      = 2;		// 1 had no landmark fields; still read
+	const uint32_t CELLS_OFFSET = 64;
+
+	class FileHeader {
+		public:
+			char     magic[8];
+			uint32_t version;
+			uint32_t cells_offset;
+			uint64_t rows;
+			uint64_t cols;
+			int32_t  start_row;
+			int32_t  start_col;
+			int32_t  goal_row;
+			int32_t  goal_col;
+			uint32_t landmark_count;
+			uint32_t reserved;
+			uint64_t landmarks_offset;
+	};
+	static_assert(sizeof(FileHeader) == CELLS_OFFSET);
+
+	// Landmark tables start at the first multiple of 8 after the cells.
+	uint64_t landmarksOffset(uint64_t cell_count){
+		return (CELLS_OFFSET + cell_count + 7) / 8 * 8;
+	}
+
+	FileHeader readHeader(const MappedFile& mapping, const std::string& path){
+		if (mapping.bytes() < CELLS_OFFSET){ throw std::invalid_argument("Not a maze file: " + path); }
+
+		FileHeader header;
+		std::memcpy(&header, mapping.data(), sizeof(header));
+		if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0){
+			throw std::invalid_argument("Not a maze file: " + path);
+		}
+		if (header.version != 1 && header.version != VERSION){
+			throw std::invalid_argument("Unsupported maze file version " + std::to_string(header.version));
+		}
+		if (header.version == 1){
+			header.landmark_count   = 0;
+			header.landmarks_offset = 0;
+		}
+		if (header.cols != 0 && header.rows > SIZE_MAX / header.cols){
+			throw std::invalid_argument("Maze in " + path + " is too large");
+		}
+		return header;
+	}
+
+}
+
+void Maze::save(const std::string& path, const Landmarks* landmarks) const{
+	/****************************************************************
+	 * @brief Writes the header and then the cells as they are in   *
+	 * memory, then the landmark tables if given.                   *
+	 * @exception std::runtime_error if the file cannot be written  *
+	 ****************************************************************/
+	FileHeader header;
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version      = VERSION;
+	header.cells_offset = CELLS_OFFSET;
+	header.rows         = rows;
+	header.cols         = cols;
+	header.start_row    = start.row;
+	header.start_col    = start.col;
+	header.goal_row     = goal.row;
+	header.goal_col     = goal.col;
+	header.reserved     = 0;
+	header.landmark_count   = (landmarks == nullptr) ? 0 : landmarks->count();
+	header.landmarks_offset = (header.landmark_count == 0) ? 0 : landmarksOffset(grid.size());
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(grid.data()), grid.size());
+	if (header.landmark_count != 0){
+		char padding[8] = {};
+		file.write(padding, header.landmarks_offset - CELLS_OFFSET - grid.size());
+		for (int cell_i: landmarks->getCells()){
+			int32_t stored = cell_i;
+			file.write(reinterpret_cast<const char*>(&stored), sizeof(stored));
+		}
+		if (header.landmark_count % 2 == 1){ file.write(padding, 4); }
+		file.write(reinterpret_cast<const char*>(landmarks->data()), grid.size() * header.landmark_count * sizeof(uint16_t));
+	}
+	if (!file){ throw std::runtime_error("Cannot write " + path); }
+}
+
+Maze Maze::open(const std::string& path){
+	/****************************************************************
+	 * @brief Maps the file and points the grid at its cells. Only  *
+	 * the header is read, so this takes the same time for any size *
+	 * of maze. Components are not labeled; call labelComponents()  *
+	 * to get O(1) rejection of unreachable queries.                *
+	 * @exception std::runtime_error if the file cannot be mapped   *
+	 * @exception std::invalid_argument if it is not a maze file    *
+	 ****************************************************************/
+	std::shared_ptr<MappedFile> mapping = std::make_shared<MappedFile>(path);
+	FileHeader                  header  = readHeader(*mapping, path);
+
+	Maze maze(
+		Position(header.start_row, header.start_col),
+		Position(header.goal_row,  header.goal_col),
+		header.rows,
+		header.cols,
+		Unfilled());
+	maze.grid = GridStorage::view(mapping, header.cells_offset, header.rows * header.cols);
+
+	if (maze.grid[maze.toIndex(maze.start)] != Contents::START || maze.grid[maze.toIndex(maze.goal)] != Contents::GOAL){
+		throw std::invalid_argument("Start or goal cell does not match the header in " + path);
+	}
+	return maze;
+}
+
+Landmarks Landmarks::open(const Maze& maze, const std::string& path){
+	/****************************************************************
+	 * @brief Maps the landmark tables of a maze file in place.     *
+	 * @exception std::runtime_error if the file cannot be mapped   *
+	 * @exception std::invalid_argument if it holds no tables, or   *
+	 * they are for a maze of another size                          *
+	 ****************************************************************/
+	std::shared_ptr<MappedFile> mapping = std::make_shared<MappedFile>(path);
+	FileHeader                  header  = readHeader(*mapping, path);
+	if (header.landmark_count == 0){ throw std::invalid_argument("No landmarks in " + path); }
+	if (header.rows != maze.getRows() || header.cols != maze.getCols()){
+		throw std::invalid_argument("Landmarks in " + path + " are for a maze of another size");
+	}
+
+	uint64_t cell_count   = header.rows * header.cols;
+	uint64_t cells_bytes  = (header.landmark_count + 1) / 2 * 8;
+	uint64_t table_offset = header.landmarks_offset + cells_bytes;
+	if (header.landmarks_offset % 8 != 0
+		|| table_offset > mapping->bytes()
+		|| (mapping->bytes() - table_offset) / sizeof(uint16_t) / header.landmark_count < cell_count){
+		throw std::invalid_argument("Landmark tables do not fit in " + path);
+	}
+
+	Landmarks landmarks(maze, Unbuilt());
+	const int32_t* stored = reinterpret_cast<const int32_t*>(mapping->data() + header.landmarks_offset);
+	for (uint32_t landmark_k = 0; landmark_k < header.landmark_count; landmark_k++){
+		landmarks.cells.push_back(stored[landmark_k]);
+	}
+	landmarks.requested = header.landmark_count;
+	landmarks.table     = reinterpret_cast<const uint16_t*>(mapping->data() + table_offset);
+	landmarks.mapping   = mapping;
+	return landmarks;
+}
@@ -0,0 +1,185 @@
+// Text mazes. See Maze::TextFormat in incl/maze.hpp for the two layouts.
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../incl/maze.hpp"
+
+namespace {
+
+	// Rows are written to a stream in chunks of about this many bytes.
+	const size_t CHUNK_BYTES = 1 << 16;
+
+	char compactChar(Contents contents){
+		return (contents == Contents::EMPTY) ? '.' : static_cast<char>(contents);
+	}
+
+	// Bytes per row, newline included.
+	size_t rowWidth(Maze::TextFormat format, size_t cols){
+		return (format == Maze::TextFormat::BOXED) ? cols*4 + 2 : cols + 1;
+	}
+
+	void writeRow(const Contents* row, size_t cols, Maze::TextFormat format, char* out){
+		if (format == Maze::TextFormat::COMPACT){
+			for (size_t col_i = 0; col_i < cols; col_i++){ out[col_i] = compactChar(row[col_i]); }
+			out[cols] = '\n';
+			return;
+		}
+		out[0] = '|';
+		for (size_t col_i = 0; col_i < cols; col_i++){
+			char* cell = out + col_i*4;
+			cell[1] = ' ';
+			cell[2] = static_cast<char>(row[col_i]);
+			cell[3] = ' ';
+			cell[4] = '|';
+		}
+		out[cols*4 + 1] = '\n';
+	}
+
+	// Collects the rows of a text maze, one line at a time.
+	class TextReader {
+
+		private:
+			Maze::TextFormat format;
+
+			void fail(const std::string& reason) const{
+				throw std::invalid_argument("Maze text, line " + std::to_string(line_count) + ": " + reason);
+			}
+
+			Contents readCell(char c, size_t col_i){
+				switch (c){
+					case ' ':
+					case '.':
+					case '*': return Contents::EMPTY;
+					case 'x': return Contents::BLOCKED;
+					case 'S':
+						if (start){ fail("more than one start"); }
+						start = Position(rows, col_i);
+						return Contents::START;
+					case 'G':
+						if (goal){ fail("more than one goal"); }
+						goal = Position(rows, col_i);
+						return Contents::GOAL;
+					default:
+						fail(std::string("unknown cell '") + c + "'");
+				}
+				return Contents::UNINT;
+			}
+
+		public:
+			std::vector<Contents>   cells;
+			size_t                  rows       = 0;
+			size_t                  cols       = 0;
+			size_t                  line_count = 0;
+			std::optional<Position> start;
+			std::optional<Position> goal;
+
+			TextReader(Maze::TextFormat format): format{format}{}
+
+			void addLine(const char* line, size_t length){
+				/*********************************************************
+				 * @brief Appends one row. Blank lines are skipped.
+				 * @exception std::invalid_argument on malformed rows
+				 *********************************************************/
+				line_count += 1;
+				if (length > 0 && line[length-1] == '\r'){ length -= 1; }
+				if (length == 0){ return; }
+
+				size_t row_cols = length;
+				if (format == Maze::TextFormat::BOXED){
+					if (length % 4 != 1 || line[0] != '|'){ fail("not a boxed row"); }
+					row_cols = length / 4;
+				}
+				if (rows == 0){ cols = row_cols; }
+				if (row_cols != cols){ fail("rows have different lengths"); }
+
+				size_t first_i = cells.size();
+				cells.resize(first_i + cols);
+				for (size_t col_i = 0; col_i < cols; col_i++){
+					if (format == Maze::TextFormat::COMPACT){
+						cells[first_i + col_i] = readCell(line[col_i], col_i);
+						continue;
+					}
+					const char* cell = line + col_i*4;
+					if (cell[1] != ' ' || cell[3] != ' ' || cell[4] != '|'){ fail("not a boxed row"); }
+					cells[first_i + col_i] = readCell(cell[2], col_i);
+				}
+				rows += 1;
+			}
+	};
+
+}
+
+size_t Maze::textSize(TextFormat format) const{
+	return rows * rowWidth(format, cols);
+}
+
+void Maze::writeText(char* buffer, TextFormat format) const{
+	/****************************************************************
+	 * @brief Writes the maze into buffer, which must have room for *
+	 * textSize(format) bytes. No terminating null is added.        *
+	 ****************************************************************/
+	size_t width = rowWidth(format, cols);
+	for (size_t row_i = 0; row_i < rows; row_i++){
+		writeRow(grid.data() + row_i*cols, cols, format, buffer + row_i*width);
+	}
+}
+
+void Maze::writeText(std::ostream& out, TextFormat format) const{
+	/****************************************************************
+	 * @brief Writes the maze to out, a chunk of rows at a time.    *
+	 ****************************************************************/
+	size_t            width     = rowWidth(format, cols);
+	size_t            per_chunk = std::max<size_t>(1, CHUNK_BYTES / width);
+	std::vector<char> chunk(std::min(per_chunk, rows) * width);
+
+	for (size_t row_i = 0; row_i < rows; row_i += per_chunk){
+		size_t chunk_rows = std::min(per_chunk, rows - row_i);
+		for (size_t i = 0; i < chunk_rows; i++){
+			writeRow(grid.data() + (row_i+i)*cols, cols, format, chunk.data() + i*width);
+		}
+		out.write(chunk.data(), chunk_rows * width);
+	}
+}
+
+Maze Maze::readText(std::istream& in, TextFormat format){
+	/****************************************************************
+	 * @brief Reads a maze written by writeText (or typed by hand)  *
+	 * from in, reusing one line buffer.                            *
+	 * @exception std::invalid_argument if the text is not a maze   *
+	 ****************************************************************/
+	TextReader  reader(format);
+	std::string line;
+	while (std::getline(in, line)){ reader.addLine(line.data(), line.size()); }
+
+	if (!reader.start || !reader.goal){ throw std::invalid_argument("Maze text needs one start and one goal"); }
+	Maze maze(*reader.start, *reader.goal, reader.rows, reader.cols, Unfilled());
+	maze.grid = GridStorage(std::move(reader.cells));
+	maze.labelComponents();
+	return maze;
+}
+
+Maze Maze::readText(const char* text, size_t size, TextFormat format){
+	/****************************************************************
+	 * @brief Same as the stream reader, for text already in memory.*
+	 ****************************************************************/
+	TextReader  reader(format);
+	const char* end = text + size;
+	while (text < end){
+		const char* newline  = static_cast<const char*>(std::memchr(text, '\n', end - text));
+		const char* line_end = (newline == nullptr) ? end : newline;
+		reader.addLine(text, line_end - text);
+		text = line_end + 1;
+	}
+
+	if (!reader.start || !reader.goal){ throw std::invalid_argument("Maze text needs one start and one goal"); }
+	Maze maze(*reader.start, *reader.goal, reader.rows, reader.cols, Unfilled());
+	maze.grid = GridStorage(std::move(reader.cells));
+	maze.labelComponents();
+	return maze;
+}
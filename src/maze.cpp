@@ -1,30 +1,55 @@
 //Macros
 
 #include <ranges>
-#include <map>
+#include <vector>
 #include <algorithm>
 #include <random>
 #include <array> 
 #include <iostream>
+#include <thread>
+#include <cstdint>
 #include "../incl/queue.hpp"
 #include "../incl/stack.hpp"
 #include "../incl/maze.hpp"
-#include "../incl/priority-queue.hpp"
+#include "../incl/indexed-heap.hpp"
+#include "../incl/bucket-queue.hpp"
+#include "../incl/search_algorithms.hpp"
 
 /*************************************************************************************************/
 
+namespace {
+
+	// Rows per tile of Maze::tiled. Fixed, so that the tiles (and therefore
+	// the RNG streams) do not depend on the thread count.
+	const size_t TILE_ROWS = 64;
+
+	uint64_t splitMix(uint64_t x){
+		x += 0x9E3779B97F4A7C15ull;
+		x  = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x  = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return x ^ (x >> 31);
+	}
+
+	// Counter-based generator: the n-th number of a stream is a hash of the
+	// stream key and n, so any cell can be drawn without drawing the others.
+	double counterUniform(uint64_t stream_key, uint64_t counter){
+		return (splitMix(stream_key ^ splitMix(counter)) >> 11) * 0x1.0p-53;
+	}
+
+}
+
 Maze::Maze
 	(Position start_pos
 	,Position goal_pos
 	,size_t	  rows
 	,size_t	  cols
-	,int      debug_seed 
-	,float    blocked_proportion
+	,Unfilled
 	)
-	:start (start_pos)
-	,goal  (goal_pos)
-	,rows  (rows)
-	,cols  (cols){
+	:start     (start_pos)
+	,goal      (goal_pos)
+	,goal_cell (goal_pos, Contents::GOAL)
+	,rows      (rows)
+	,cols      (cols){
 
 	DEBUG_MSG("---   DEBUG ON   ---");
 	DEBUG_MSG("Uncomment preprocessor NDEBUG definition to turn off.");
@@ -50,360 +75,502 @@ Maze::Maze
 	if (less_than_zero_pos || bigger_than_maze_pos){
 		throw std::invalid_argument("Illegal positions for size of maze");
 	}
-	
+}
+
+Maze::Maze
+	(Position start_pos
+	,Position goal_pos
+	,size_t	  rows
+	,size_t	  cols
+	,int      debug_seed 
+	,float    blocked_proportion
+	)
+	:Maze(start_pos, goal_pos, rows, cols, Unfilled()){
+
 	// Variable initialization
 	int blocked_count       = floor(rows*cols*blocked_proportion);
 	int variable_cell_count = (rows*cols)-2;
-	int start_i             = start_pos.row * cols + start_pos.col;
-	int goal_i              = goal_pos.row  * cols + goal_pos.col;
-	std::random_device rd; 		// Non-deterministic random device for seed
-	std::mt19937 rng(rd());		// Merssene Twister from algorithm library. 
-	if (debug_seed != -1){rng = std::mt19937(debug_seed);}
+	int start_i             = this->toIndex(start_pos);
+	int goal_i              = this->toIndex(goal_pos);
+	std::mt19937 rng;		// Merssene Twister from algorithm library. 
+	if (debug_seed != -1){ rng.seed(debug_seed); }
+	else                 { rng.seed(std::random_device()()); }
 
 	DEBUG_MSG("Creating maze skeleton.");
 
-	//Add all non-start or end cells
-	for (int i: std::views::iota(0, (variable_cell_count))){
-		Contents cell_contents = (i < blocked_count)
-			? Contents::BLOCKED
-			: Contents::EMPTY;
-		grid.push_back(Cell(cell_contents));
-	}
+	// Shuffle only the contents of the variable cells, one byte each. The
+	// permutation is the same as shuffling whole cells would give, so a
+	// debug_seed keeps producing the same maze.
+	std::vector<Contents> skeleton(variable_cell_count, Contents::EMPTY);
+	std::fill_n(skeleton.begin(), std::min(blocked_count, variable_cell_count), Contents::BLOCKED);
 
 	DEBUG_MSG("Shuffling skeleton.");
+	std::shuffle(std::begin(skeleton), std::end(skeleton), rng);
+
+	DEBUG_MSG("Writing cells, start and goal.");
 
-	// Shuffle maze
-	std::shuffle(std::begin(grid), std::end(grid), rng);
-	
-	DEBUG_MSG("Inserting start and end.");
-	
-	// Add start and goal.
-	if (start_i < goal_i){
-		grid.insert(grid.begin()+start_i, Cell(Contents::START));
-		grid.insert(grid.begin()+goal_i, Cell(Contents::GOAL));
-	} else {
-		grid.insert(grid.begin()+goal_i , Cell(Contents::GOAL));
-		grid.insert(grid.begin()+start_i, Cell(Contents::START));
+	// One pass, with start and goal written in place.
+	grid.resize(this->getSize());
+	int skeleton_i = 0;
+	for (int cell_i = 0; cell_i < this->getSize(); cell_i++){
+		if      (cell_i == start_i){ grid[cell_i] = Contents::START; }
+		else if (cell_i == goal_i) { grid[cell_i] = Contents::GOAL; }
+		else                       { grid[cell_i] = skeleton[skeleton_i++]; }
 	}
 
-	DEBUG_MSG("Initializing positions.");
+	DEBUG_MSG("Labeling components.");
+	this->labelComponents();
+}
 
-	// Initialize positions
-	for (int row_i=0; row_i<rows; row_i++){
-		for (int col_i=0; col_i<cols; col_i++){
-			grid[(row_i*cols)+col_i].setPosition(row_i,col_i);
+Maze Maze::tiled
+	(Position start_pos
+	,Position goal_pos
+	,size_t   rows
+	,size_t   cols
+	,uint64_t seed
+	,float    blocked_proportion
+	,unsigned thread_count
+	){
+	/*******************************************************************
+	* Generates the cells in bands of TILE_ROWS rows, several bands at *
+	* once. Every band draws from its own counter-based stream, so the *
+	* maze only depends on the seed, never on thread_count. Each cell  *
+	* is blocked with probability blocked_proportion, so the number of *
+	* blocked cells is only close to the proportion, not exact as with *
+	* the constructor.                                                 *
+	********************************************************************/
+	Maze   maze(start_pos, goal_pos, rows, cols, Unfilled());
+	size_t tile_count = (rows + TILE_ROWS - 1) / TILE_ROWS;
+	maze.grid.resize(maze.getSize());
+
+	auto fillTiles = [&](size_t first_tile, size_t tile_step){
+		for (size_t tile = first_tile; tile < tile_count; tile += tile_step){
+			uint64_t stream_key = splitMix(seed ^ splitMix(tile));
+			size_t   first_i    = tile * TILE_ROWS * cols;
+			size_t   last_i     = std::min(rows, (tile + 1) * TILE_ROWS) * cols;
+			for (size_t cell_i = first_i; cell_i < last_i; cell_i++){
+				maze.grid[cell_i] = counterUniform(stream_key, cell_i - first_i) < blocked_proportion
+					? Contents::BLOCKED
+					: Contents::EMPTY;
+			}
 		}
+	};
+
+	thread_count = std::max(1u, std::min<unsigned>(thread_count, tile_count));
+	std::vector<std::thread> workers;
+	for (unsigned worker = 1; worker < thread_count; worker++){
+		workers.emplace_back(fillTiles, worker, thread_count);
 	}
+	fillTiles(0, thread_count);
+	for (std::thread& worker: workers){ worker.join(); }
+
+	maze.grid[maze.toIndex(start_pos)] = Contents::START;
+	maze.grid[maze.toIndex(goal_pos)]  = Contents::GOAL;
+	maze.labelComponents();
+	return maze;
 }
 
 
-Cell& Maze::getCell(int row, int col){
-	return grid[(row*cols)+col];
+Cell Maze::getCell(int row, int col) const{
+	return Cell(Position(row, col), grid[(row*cols)+col]);
 }
 
 
-size_t Maze::getRows(){return rows;}
-size_t Maze::getCols(){return cols;}
-size_t Maze::getSize(){return (cols*rows);}
+size_t   Maze::getRows() const              {return rows;}
+size_t   Maze::getCols() const              {return cols;}
+size_t   Maze::getSize() const              {return (cols*rows);}
+int      Maze::toIndex(Position pos) const  {return (pos.row*cols)+pos.col;}
+Position Maze::toPosition(int index) const  {return Position(index/cols, index%cols);}
+bool     Maze::isBlocked(int index) const   {return grid[index] == Contents::BLOCKED;}
+
+const std::vector<int>& Maze::getEdits() const {return edits;}
+
+bool Maze::hasComponents() const {return !component.empty();}
+
+bool Maze::connected(Position from, Position to) const{
+	if (component.empty()){return true;}
+	int label = component[this->toIndex(from)];
+	return (label != -1 && label == component[this->toIndex(to)]);
+}
+
+int Maze::componentOf(Position pos) const {return component.empty() ? -1 : component[this->toIndex(pos)];}
+int Maze::componentCount() const          {return component_count;}
+int Maze::labelBound() const              {return component_size.size();}
+int Maze::componentSize(int label) const  {return component_size[label];}
 
-void Maze::pushSearchLocations(
-	Cell*                cell, 
-	Stack<Cell*>&        search_stack, 
-	std::map<int, bool>& searched_index){
+int Maze::newLabel(){
 	/*******************************************************************
-	* Goes through the adjacent cells to a cell and pushes those that  *
-	* are "valid" (not blocked or in path) into a stack that is passed *
-	* by the user.                                                     *
+	* An unused label with a size of 0, recycled if one is free.       *
 	********************************************************************/
-	DEBUG_MSG(std::string("Called pushSearchLocations on the cell at: ")
-			+ posToString((*cell).getPosition()));
-
-	searched_index[(*cell).toInt()] = true;
-	//None of these can be references because they're rvalues.
-	Position start_pos = cell->getPosition(); 
-	Position west_pos  = Position(start_pos.row  , start_pos.col-1); 
-	Position east_pos  = Position(start_pos.row  , start_pos.col+1);
-	Position north_pos = Position(start_pos.row-1, start_pos.col);
-	Position south_pos = Position(start_pos.row+1, start_pos.col);
-
-	//std::array is a pointer + size. Worth the small memory cost over c-style
-	//arrays in most instances
-	std::array<Position, 4> directions;		
-	directions[0] = north_pos;
-	directions[1] = south_pos;
-	directions[2] = west_pos;
-	directions[3] = east_pos;
-
-	// Go through each item in directions
-	for (int i = 0; i<4; i++){
-		DEBUG_MSG("In directions loop for the position:"
-				+ posToString(directions[i]));
-		Position cur_pos = directions[i];
-		if (cur_pos.col < 0 || cur_pos.row < 0)                    {continue;}
-		if (cur_pos.col >= this->cols || cur_pos.row >= this->rows){continue;}
+	component_count += 1;
+	if (free_labels.empty()){
+		component_size.push_back(0);
+		return component_size.size() - 1;
+	}
+	int label = free_labels.back();
+	free_labels.pop_back();
+	return label;
+}
 
-		Cell* cur_cell  = &this->getCell(cur_pos.row, cur_pos.col);
-		bool is_searched = searched_index[(*cur_cell).toInt()]; 
-		bool is_blocked  = cur_cell->getContents() == Contents::BLOCKED; 
+void Maze::dropLabel(int label){
+	component_size[label] = 0;
+	component_count      -= 1;
+	free_labels.push_back(label);
+}
 
-		if (is_blocked || is_searched)                             {continue;}
+int Maze::floodComponent(int from_i, int label){
+	/*******************************************************************
+	* Gives label to every free cell reachable from from_i that does  *
+	* not have it yet, and returns how many cells were relabeled.     *
+	********************************************************************/
+	std::vector<int> to_visit = {from_i};
+	int              count    = 0;
+	component[from_i] = label;
+
+	while (!to_visit.empty()){
+		int      cell_i = to_visit.back();
+		Position pos    = this->toPosition(cell_i);
+		to_visit.pop_back();
+		count += 1;
+
+		std::array<Position, 4> directions = {
+			Position(pos.row-1, pos.col),
+			Position(pos.row+1, pos.col),
+			Position(pos.row  , pos.col-1),
+			Position(pos.row  , pos.col+1)
+		};
+		for (Position cur_pos: directions){
+			if (cur_pos.col < 0 || cur_pos.row < 0)                    {continue;}
+			if (cur_pos.col >= this->cols || cur_pos.row >= this->rows){continue;}
+			int cur_i = this->toIndex(cur_pos);
+			if (this->isBlocked(cur_i) || component[cur_i] == label)  {continue;}
+			component[cur_i] = label;
+			to_visit.push_back(cur_i);
+		}
+	}
+	return count;
+}
 
-		searched_index[(*cur_cell).toInt()] = 1;
-		cur_cell->setParent(*cell);
-		search_stack.push(cur_cell);
-		this->push_count += 1;
-		DEBUG_MSG("    Pushed successfully");
+void Maze::labelComponents(){
+	/*******************************************************************
+	* Labels every component of the maze from scratch.                 *
+	* Time Complexity: O(rows*cols)                                    *
+	********************************************************************/
+	component.assign(this->getSize(), -1);
+	component_size.clear();
+	free_labels.clear();
+	component_count = 0;
+	flood_mark.assign(this->getSize(), 0);
+	flood_stamp     = 0;
+
+	for (int cell_i = 0; cell_i < this->getSize(); cell_i++){
+		if (this->isBlocked(cell_i) || component[cell_i] != -1){continue;}
+		int label = this->newLabel();
+		component_size[label] = this->floodComponent(cell_i, label);
 	}
-		DEBUG_MSG("Exited directions Loop");
 }
 
-void Maze::pushSearchLocations(
-	Cell*                cell, 
-	Queue<Cell*>&        search_queue, 
-	std::map<int, bool>& searched_index){
+void Maze::splitComponent(int old_label, const std::array<int, 4>& seeds, int seed_count){
 	/*******************************************************************
-	*oes through the adjacent cells to a cell and pushes those that  *
-	* are "valid" (not blocked or in path) into a queue that is passed *
-	* by the user.                                                     *
+	* The cells in seeds were neighbors of a cell that just got        *
+	* blocked. One BFS runs from each seed, taking turns a cell at a   *
+	* time, and floods that meet are merged. A group of floods that    *
+	* runs out of cells has found all of its piece. Once at most one   *
+	* group is still going, it keeps old_label and the finished ones   *
+	* get new labels. Each flood that finishes costs the size of its   *
+	* piece, and the others cost at most as much, but seeds in the     *
+	* same piece only stop once their floods meet. When the way round  *
+	* the blocked cell is long, e.g. it cut a ring, that takes         *
+	* O(component) even though nothing splits.                         *
 	********************************************************************/
-	DEBUG_MSG(std::string("Called pushSearchLocations on the cell at: ")
-			+ posToString((*cell).getPosition()));
-
-	searched_index[(*cell).toInt()] = true;
-	//None of these can be references because they're rvalues.
-	Position start_pos = cell->getPosition();
-	Position west_pos  = Position(start_pos.row  , start_pos.col-1);
-	Position east_pos  = Position(start_pos.row  , start_pos.col+1);
-	Position north_pos = Position(start_pos.row-1, start_pos.col);
-	Position south_pos = Position(start_pos.row+1, start_pos.col);
-
-	//std::array is a pointer + size. Worth the small memory cost over c-style
-	//arrays in most instances
-	std::array<Position, 4> directions;		
-	directions[0] = north_pos;
-	directions[1] = south_pos;
-	directions[2] = west_pos;
-	directions[3] = east_pos;
-
-	// Go through each item in directions
-	for (int i = 0; i<4; i++){
-		DEBUG_MSG("In directions loop for the position:"
-				+ posToString(directions[i]));
-		Position cur_pos = directions[i];
+	if (flood_stamp > UINT32_MAX - 4){
+		std::fill(flood_mark.begin(), flood_mark.end(), 0);
+		flood_stamp = 0;
+	}
+	uint32_t base = flood_stamp + 1;
+	flood_stamp  += seed_count;
+
+	// visited[k] is flood k's BFS queue; cells before head[k] are expanded.
+	std::array<std::vector<int>, 4> visited;
+	std::array<size_t, 4>           head  = {0, 0, 0, 0};
+	std::array<int, 4>              group = {0, 1, 2, 3};
+	auto find = [&](int flood_k){
+		while (group[flood_k] != flood_k){ flood_k = group[flood_k]; }
+		return flood_k;
+	};
+	auto running = [&](int root){
+		for (int flood_k = 0; flood_k < seed_count; flood_k++){
+			if (find(flood_k) == root && head[flood_k] < visited[flood_k].size()){ return true; }
+		}
+		return false;
+	};
+	for (int flood_k = 0; flood_k < seed_count; flood_k++){
+		flood_mark[seeds[flood_k]] = base + flood_k;
+		visited[flood_k].push_back(seeds[flood_k]);
+	}
+
+	while (true){
+		int running_groups = 0;
+		for (int flood_k = 0; flood_k < seed_count; flood_k++){
+			if (find(flood_k) == flood_k && running(flood_k)){ running_groups += 1; }
+		}
+		if (running_groups <= 1){ break; }
+
+		for (int flood_k = 0; flood_k < seed_count; flood_k++){
+			if (head[flood_k] == visited[flood_k].size()){ continue; }
+			int      cell_i = visited[flood_k][head[flood_k]++];
+			Position pos    = this->toPosition(cell_i);
+			std::array<Position, 4> directions = {
+				Position(pos.row-1, pos.col),
+				Position(pos.row+1, pos.col),
+				Position(pos.row  , pos.col-1),
+				Position(pos.row  , pos.col+1)
+			};
+			for (Position cur_pos: directions){
+				if (cur_pos.col < 0 || cur_pos.row < 0)                    {continue;}
+				if (cur_pos.col >= this->cols || cur_pos.row >= this->rows){continue;}
+				int cur_i = this->toIndex(cur_pos);
+				if (component[cur_i] != old_label)                         {continue;}
+
+				uint32_t mark = flood_mark[cur_i];
+				if (mark >= base && mark < base + seed_count){
+					int other = find(mark - base);
+					int mine  = find(flood_k);
+					if (other != mine){ group[other] = mine; }
+					continue;
+				}
+				flood_mark[cur_i] = base + flood_k;
+				visited[flood_k].push_back(cur_i);
+			}
+		}
+	}
+
+	// The group still running keeps the label. If all of them finished
+	// together, the largest one does.
+	std::array<size_t, 4> piece_size = {0, 0, 0, 0};
+	for (int flood_k = 0; flood_k < seed_count; flood_k++){ piece_size[find(flood_k)] += visited[flood_k].size(); }
+	int keeper = -1;
+	for (int root = 0; root < seed_count; root++){
+		if (find(root) != root){ continue; }
+		if (running(root)){ keeper = root; break; }
+		if (keeper == -1 || piece_size[root] > piece_size[keeper]){ keeper = root; }
+	}
+
+	for (int root = 0; root < seed_count; root++){
+		if (find(root) != root || root == keeper){ continue; }
+		int label = this->newLabel();
+		for (int flood_k = 0; flood_k < seed_count; flood_k++){
+			if (find(flood_k) != root){ continue; }
+			for (int cell_i: visited[flood_k]){ component[cell_i] = label; }
+		}
+		component_size[label]      = piece_size[root];
+		component_size[old_label] -= piece_size[root];
+	}
+}
+
+void Maze::markAsBlocked(int row, int col){
+	/*******************************************************************
+	* Blocking a cell can split its component, but only if at least   *
+	* two of its neighbors were in it; splitComponent works out the    *
+	* pieces.                                                          *
+	********************************************************************/
+	int       cell_i   = this->toIndex(Position(row, col));
+	Contents& contents = grid[cell_i];
+	if (contents == Contents::START || contents == Contents::GOAL){
+		throw std::invalid_argument("Cannot block the start or the goal");
+	}
+	if (contents == Contents::BLOCKED){return;}
+	contents = Contents::BLOCKED;
+	edits.push_back(cell_i);
+	if (component.empty()){return;}
+
+	int old_label = component[cell_i];
+	component[cell_i]          = -1;
+	component_size[old_label] -= 1;
+
+	std::array<int, 4>      seeds;
+	int                     seed_count = 0;
+	std::array<Position, 4> directions = {
+		Position(row-1, col), Position(row+1, col), Position(row, col-1), Position(row, col+1)
+	};
+	for (Position cur_pos: directions){
 		if (cur_pos.col < 0 || cur_pos.row < 0)                    {continue;}
 		if (cur_pos.col >= this->cols || cur_pos.row >= this->rows){continue;}
+		int cur_i = this->toIndex(cur_pos);
+		if (component[cur_i] == old_label){ seeds[seed_count++] = cur_i; }
+	}
 
-		Cell* cur_cell  = &this->getCell(cur_pos.row, cur_pos.col);
-		bool is_searched = searched_index[(*cur_cell).toInt()]; 
-		bool is_blocked  = cur_cell->getContents() == Contents::BLOCKED; 
+	if      (seed_count == 0){ this->dropLabel(old_label); }
+	else if (seed_count >= 2){ this->splitComponent(old_label, seeds, seed_count); }
+}
 
-		if (is_blocked || is_searched)                             {continue;}
+void Maze::markAsEmpty(int row, int col){
+	/*******************************************************************
+	* Freeing a cell joins the components around it. They all take    *
+	* the label of the largest one, so only the smaller ones are      *
+	* relabeled.                                                      *
+	********************************************************************/
+	int cell_i  = this->toIndex(Position(row, col));
+	if (grid[cell_i] != Contents::BLOCKED){return;}
+	grid[cell_i] = Contents::EMPTY;
+	edits.push_back(cell_i);
+	if (component.empty()){return;}
+
+	int largest = -1;
+	std::array<Position, 4> directions = {
+		Position(row-1, col), Position(row+1, col), Position(row, col-1), Position(row, col+1)
+	};
+	for (Position cur_pos: directions){
+		if (cur_pos.col < 0 || cur_pos.row < 0)                    {continue;}
+		if (cur_pos.col >= this->cols || cur_pos.row >= this->rows){continue;}
+		int label = component[this->toIndex(cur_pos)];
+		if (label == -1)                                           {continue;}
+		if (largest == -1 || component_size[label] > component_size[largest]){largest = label;}
+	}
+
+	if (largest == -1){ largest = this->newLabel(); }
+	component[cell_i]        = largest;
+	component_size[largest] += 1;
 
-		searched_index[(*cur_cell).toInt()] = 1;
-		cur_cell->setParent(*cell);
-		search_queue.push(cur_cell);
-		this->push_count += 1;
-		DEBUG_MSG("    Pushed successfully");
+	// Every other neighboring component is merged into the largest one.
+	// The freed cell already has its label, so a flood cannot pass through
+	// it into a neighbor that has not been counted yet.
+	for (Position cur_pos: directions){
+		if (cur_pos.col < 0 || cur_pos.row < 0)                    {continue;}
+		if (cur_pos.col >= this->cols || cur_pos.row >= this->rows){continue;}
+		int label = component[this->toIndex(cur_pos)];
+		if (label == -1 || label == largest)                       {continue;}
+		component_size[largest] += component_size[label];
+		this->dropLabel(label);
+		this->floodComponent(this->toIndex(cur_pos), largest);
 	}
-		DEBUG_MSG("Exited directions Loop");
 }
 
 double Maze::manhattan(Cell* n){
+	return this->manhattan(n->getPosition(), this->goal);
+}
 
-	Cell& goal = this->getCell(this->goal.row,this->goal.col);
-	Position goal_pos = goal.getPosition();
-	Position n_pos = n->getPosition();
+double Maze::manhattan(Position from, Position to) const{
 
-	double row_diff = std::abs(goal_pos.row - n_pos.row);
-	double col_diff = std::abs(goal_pos.col - n_pos.col);
-		
+	double row_diff = std::abs(to.row - from.row);
+	double col_diff = std::abs(to.col - from.col);
 
 	return (row_diff + col_diff);
 }
 
-void Maze::pushSearchLocations(
-	Cell*                         n, 
-	PriorityQueue<double, Cell*>& to_explore, 
-	std::map<int, double>&        explored){
-
-	
-	DEBUG_MSG(std::string("Called pushSearchLocations on the cell at: ")
-			+ posToString(n->getPosition()));
-
-	//None of these can be references because they're rvalues.
-	Position start_pos = n->getPosition();
-	Position west_pos  = Position(start_pos.row  , start_pos.col-1);
-	Position east_pos  = Position(start_pos.row  , start_pos.col+1);
-	Position north_pos = Position(start_pos.row-1, start_pos.col);
-	Position south_pos = Position(start_pos.row+1, start_pos.col);
-
-	//std::array is a pointer + size. Worth the small memory cost over c-style
-	//arrays in most instances
-	std::array<Position, 4> directions;		
-	directions[0] = north_pos;
-	directions[1] = south_pos;
-	directions[2] = west_pos;
-	directions[3] = east_pos;
-
-	// Go through each item in directions
-	for (int i = 0; i<4; i++){
-		DEBUG_MSG("In directions loop for the position:"
-				+ posToString(directions[i]));
-		Position m_pos = directions[i];
-		if (m_pos.col < 0 || m_pos.row < 0)                    {continue;}
-		if (m_pos.col >= this->cols || m_pos.row >= this->rows){continue;}
-
-		Cell* m         = &this->getCell(m_pos.row, m_pos.col);
-
-		DEBUG_MSG("Checking if blocked");
-		bool is_blocked = m->getContents() == Contents::BLOCKED; 
-		if (is_blocked) {continue;}
-
-		//Get Updated values
-		double updated_g_m = (explored[n->toInt()])+1;
-		double updated_h_m = this->manhattan(m);		//This is not needed i think
-		double updated_f_m = updated_h_m + updated_g_m;
-
-		DEBUG_MSG("Checking if smaller or unchecked");
-		double cur_g_m  = explored[n->toInt()]+1; 
-		if (!(updated_g_m < cur_g_m) && m->g_n != -1){continue;}
-		
-		//Update state in cell
-		DEBUG_MSG("Updating state in cell");
-		m->setParent(*n);
-		m->h_n = updated_h_m;	
-		m->g_n = updated_g_m;
-
-		//Update state in explored and to_explore
-		DEBUG_MSG("Updating state in explored and to_explore");
-		explored[m->toInt()] = updated_g_m;
-		to_explore.insert(updated_f_m, m);
-
-		//Book-keeping
-		this->push_count += 1;
-		DEBUG_MSG("    Pushed successfully");
-	}
-		DEBUG_MSG("Exited directions Loop");
-
-}
-
 void Maze::resetStats(){
 	this->path_length = 0;
 	this->push_count  = 0;
 	this->path_found  = false;
+	this->last_search.path.clear();
 }
 
-void Maze::updatePath(){
+std::optional<Cell*> Maze::updatePath(const SearchResult& result){
 	/****************************************************************
-	 * Goes throught the path, from end to beginning, and marks the *
-	 * cells in path as such. If there is no path, then the method  *
-	 * does not change anything                                     *
+	 * Copies the result of a search on last_search into the stats  *
+	 * of the maze, so that showPath() can draw it. If there is no  *
+	 * path, then the method does not change anything               *
 	 ****************************************************************/
-	Cell* cur_cell = &this->getCell(goal.row,goal.col);
-	while (cur_cell->getParent() != nullptr){
-		Contents cur_contents = cur_cell->getContents();
-		if (cur_contents != Contents::GOAL){
-			this->path_length += 1;
-			cur_cell->markOnPath();
-		}
-		cur_cell = cur_cell->getParent();
-	}
+	this->push_count = result.push_count;
+	if (!result.path_found){return std::nullopt;}
+
+	this->path_found  = true;
+	this->path_length = result.path_length;
+	return &this->goal_cell;
+}
+
+std::optional<Position> Maze::getParent(int row, int col){
+	if (!path_found){return std::nullopt;}
+	int parent_i = last_search.parent[this->toIndex(Position(row, col))];
+	if (parent_i == -1){return std::nullopt;}
+	return this->toPosition(parent_i);
 }
 
 //////////////////////////////////////////////////////////////////////////////
-std::optional<Cell*> Maze::a_star(Maze* maze){
+SearchResult Maze::a_star(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal,
+	Frontier       frontier){
+	/*****************************************************************
+	 * A* with the Manhattan distance, over either open list.        *
+	 *****************************************************************/
+	if (frontier == Frontier::BUCKETS){
+		return gridSearch<BucketFrontier, ManhattanHeuristic, FourConnected, VisitOnPop>(maze, context, start, goal);
+	}
+	return gridSearch<HeapFrontier, ManhattanHeuristic, FourConnected, VisitOnPop>(maze, context, start, goal);
+}
 
-	DEBUG_MSG("IN A-STAR"); 
-	PriorityQueue<double, Cell*> to_explore; 
-	std::map<int, double>   explored;
-
-	DEBUG_MSG("GETTING START CELL:"); 
-	Cell* n = &maze->getCell(maze->start.row, maze->start.col);
-	DEBUG_MSG(n->getPosition().col + n->getPosition().row); 
-	double g_n = n->g_n = 0.0;
-	double h_n = n->h_n = maze->manhattan(n);
-	double f_n = g_n + g_n;
-	
-	DEBUG_MSG("Inserting into PQ"); 
-	to_explore.insert(f_n, n);
-	DEBUG_MSG("Updating Map"); 
-	explored[n->toInt()] = g_n;
-
-	while (!to_explore.is_empty()){
-		DEBUG_MSG("Exploring loop for entry at:"); 
-		Entry<double, Cell*> e = to_explore.remove_min();
-		DEBUG_MSG(e.key); 
-		n = e.value;
-
-		if (n == &maze->getCell(maze->goal.row, maze->goal.col)){
-			DEBUG_MSG("Path found, updating:"); 
-			maze->path_found = true;
-			maze->updatePath();
-			return n;
-		}
+SearchResult Maze::a_star(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal){
+	return Maze::a_star(maze, context, start, goal, Frontier::HEAP);
+}
 
-		maze->pushSearchLocations(n, to_explore, explored);	
+SearchResult Maze::dijkstra(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal,
+	Frontier       frontier){
+	if (frontier == Frontier::BUCKETS){
+		return gridSearch<BucketFrontier, NoHeuristic, FourConnected, VisitOnPop>(maze, context, start, goal);
 	}
-return std::nullopt;
+	return gridSearch<HeapFrontier, NoHeuristic, FourConnected, VisitOnPop>(maze, context, start, goal);
+}
+
+SearchResult Maze::dijkstra(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal){
+	return Maze::dijkstra(maze, context, start, goal, Frontier::HEAP);
+}
+
+std::optional<Cell*> Maze::a_star(Maze* maze){
+	maze->resetStats();
+	SearchResult result = Maze::a_star(*maze, maze->last_search, maze->start, maze->goal);
+	return maze->updatePath(result);
 }
 
 //////////////////////////////////////////////////////////////////////////////
-std::optional<Cell*> Maze::dfs(Maze* maze){
+SearchResult Maze::dfs(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal){
 	/*****************************************************************
 	 * Performs a Depth-first-search on the maze to find the goal    *
 	 * from the start.                                               *
 	 *****************************************************************/
-	std::optional<Cell*> return_value;
-	Stack<Cell*>         search_stack;
-	Cell*                cur_cell  = &maze->getCell(maze->start.row, maze->start.col);
-	Cell*                goal_cell = &maze->getCell(maze->goal.row , maze->goal.col);
-	std::map<int, bool> searched_index;
+	return gridSearch<StackFrontier, NoHeuristic, FourConnected, VisitOnPush>(maze, context, start, goal);
+}
 
+std::optional<Cell*> Maze::dfs(Maze* maze){
 	maze->resetStats();
-
-	while (cur_cell != goal_cell){
-		DEBUG_MSG("In DFS Loop");
-		maze->pushSearchLocations(cur_cell, search_stack, searched_index);
-		if (search_stack.isEmpty()){break;}
-		cur_cell = search_stack.pop();
-	}
-
-	if (cur_cell == goal_cell){
-		return_value = cur_cell;
-		maze->path_found = true;
-		maze->updatePath();
-	}
-
-	return return_value;
+	SearchResult result = Maze::dfs(*maze, maze->last_search, maze->start, maze->goal);
+	return maze->updatePath(result);
 }
 
-std::optional<Cell*> Maze::bfs(Maze* maze){
+SearchResult Maze::bfs(
+	const Maze&    maze,
+	SearchContext& context,
+	Position       start,
+	Position       goal){
 	/*****************************************************************
 	 * Performs a Breath-first-search on the maze to find the goal   *
 	 * from the start.                                               *
 	 *****************************************************************/
-	std::optional<Cell*> return_value;
-	Queue<Cell*>         search_queue;
-	Cell*                cur_cell  = &maze->getCell(maze->start.row, maze->start.col);
-	Cell*                goal_cell = &maze->getCell(maze->goal.row , maze->goal.col);
-	std::map<int, bool> searched_index;
+	return gridSearch<QueueFrontier, NoHeuristic, FourConnected, VisitOnPush>(maze, context, start, goal);
+}
 
+std::optional<Cell*> Maze::bfs(Maze* maze){
 	maze->resetStats();
-
-	while (cur_cell != goal_cell){
-		DEBUG_MSG("In DFS Loop");
-		maze->pushSearchLocations(cur_cell, search_queue, searched_index);
-		if (search_queue.isEmpty()){break;}
-		cur_cell = search_queue.pop();
-	}
-
-	if (cur_cell == goal_cell){
-		return_value = cur_cell;
-		maze->path_found = true;
-		maze->updatePath();
-	}
-
-	return return_value;
+	SearchResult result = Maze::bfs(*maze, maze->last_search, maze->start, maze->goal);
+	return maze->updatePath(result);
 }
 
 
@@ -418,16 +585,20 @@ void Maze::showPath(){
 }
 
 std::string Maze::toString(){
-	std::cout << "in string";
-	std::string return_str; 
-	for (int row_i = 0; row_i < rows; row_i++){
-		return_str.append("|");
-		for (int col_i = 0; col_i < cols; col_i++){
-			int cell_i = (row_i * cols) + col_i;
-			return_str.append(" " + grid[cell_i].toString() + " |");
-		}
-		return_str.append("\n");
+	/****************************************************************
+	 * Draws the grid. The cells on the path of the last Maze*      *
+	 * search, if any, are drawn as PATH without touching the grid. *
+	 ****************************************************************/
+	std::string return_str(this->textSize(TextFormat::BOXED), ' ');
+	this->writeText(return_str.data(), TextFormat::BOXED);
+	return_str.pop_back();	// no newline after the last row
+
+	// Each row takes "|" + 4 chars per cell + "\n"
+	const std::vector<int>& path = this->last_search.path;
+	for (int path_i = 1; path_i + 1 < (int)path.size(); path_i++){
+		Position pos = this->toPosition(path[path_i]);
+		size_t   str_i = pos.row*(cols*4 + 2) + pos.col*4 + 2;
+		return_str[str_i] = static_cast<char>(Contents::PATH);
 	}
-	return_str.erase(return_str.end()-1, return_str.end());
 	return return_str;
 }
@@ -0,0 +1,214 @@
+#include <array>
+#include <limits>
+#include <algorithm>
+#include "../incl/parallel-a-star.hpp"
+
+namespace {
+
+	// Side of the square blocks that are hashed to pick an owner.
+	const int BLOCK = 4;
+
+	// Expansions between two looks at the mailbox.
+	const int EXPANSIONS = 64;
+
+	const double NO_PATH = std::numeric_limits<double>::infinity();
+
+}
+
+ParallelAStar::ParallelAStar(const Maze& maze, unsigned thread_count):
+	maze         {maze},
+	thread_count {std::max(thread_count, 1u)}{
+	for (unsigned worker_i = 0; worker_i < this->thread_count; worker_i++){
+		workers.push_back(std::make_unique<Worker>());
+		workers.back()->outbox.resize(this->thread_count);
+	}
+}
+
+ParallelAStar::~ParallelAStar(){
+	for (std::unique_ptr<Worker>& worker: workers){
+		for (Batch* batch = worker->mailbox.exchange(nullptr); batch != nullptr; ){
+			Batch* next = batch->next;
+			delete batch;
+			batch = next;
+		}
+	}
+}
+
+unsigned ParallelAStar::threadCount() const {return thread_count;}
+
+unsigned ParallelAStar::ownerOf(int cell_i) const{
+	uint64_t block = uint64_t(cell_i / maze.getCols() / BLOCK) << 32 | (cell_i % maze.getCols() / BLOCK);
+	block ^= block >> 33;
+	block *= 0xff51afd7ed558ccdULL;
+	block ^= block >> 33;
+	return block % thread_count;
+}
+
+void ParallelAStar::relax(Worker& worker, const Message& message){
+	/*************************************************************************
+	 * Applies a candidate g to a cell owned by worker. Reaching the goal   *
+	 * may lower the incumbent.                                             *
+	 *************************************************************************/
+	double& g = context->g[message.cell_i];
+	if (g != -1 && !(message.g < g)){ return; }
+	g = message.g;
+	context->parent[message.cell_i] = message.parent_i;
+	worker.pushed += 1;
+
+	if (message.cell_i == goal_i){
+		double current = best.load();
+		while (message.g < current && !best.compare_exchange_weak(current, message.g)){}
+		return;
+	}
+	Position pos = maze.toPosition(message.cell_i);
+	worker.open.update(message.cell_i, message.g + maze.manhattan(pos, maze.toPosition(goal_i)));
+}
+
+void ParallelAStar::send(Worker& worker){
+	/*************************************************************************
+	 * Posts every non-empty outbox as one batch. Each batch is counted in  *
+	 * active before it becomes visible to its owner.                       *
+	 *************************************************************************/
+	for (unsigned owner = 0; owner < thread_count; owner++){
+		std::vector<Message>& outbox = worker.outbox[owner];
+		if (outbox.empty()){ continue; }
+
+		Batch* batch = new Batch();
+		batch->messages.swap(outbox);
+		active.fetch_add(1);
+		std::atomic<Batch*>& mailbox = workers[owner]->mailbox;
+		batch->next = mailbox.load();
+		while (!mailbox.compare_exchange_weak(batch->next, batch)){}
+		this->wake(*workers[owner]);
+	}
+}
+
+void ParallelAStar::wake(Worker& worker){
+	worker.wakeups.fetch_add(1);
+	worker.wakeups.notify_one();
+}
+
+void ParallelAStar::finishWork(int units){
+	/*************************************************************************
+	 * Takes units off active. Whoever brings it to zero wakes everyone up *
+	 * so that they see the search is over.                                *
+	 *************************************************************************/
+	if (active.fetch_sub(units) != units){ return; }
+	for (std::unique_ptr<Worker>& worker: workers){ this->wake(*worker); }
+}
+
+void ParallelAStar::work(unsigned worker_i){
+	/*************************************************************************
+	 * Applies incoming batches, expands a few cells below the incumbent,   *
+	 * sends what it found and, once there is nothing worth expanding,      *
+	 * sleeps until more mail comes or active drops to zero.                *
+	 *************************************************************************/
+	Worker& me   = *workers[worker_i];
+	bool    busy = true;
+	int     cols = maze.getCols();
+	int     rows = maze.getRows();
+
+	while (true){
+		unsigned wakeups = me.wakeups.load();
+		Batch*   batch   = me.mailbox.exchange(nullptr);
+		if (batch != nullptr && !busy){
+			active.fetch_add(1);
+			busy = true;
+		}
+		int applied = 0;
+		while (batch != nullptr){
+			for (const Message& message: batch->messages){ this->relax(me, message); }
+			Batch* next = batch->next;
+			delete batch;
+			batch    = next;
+			applied += 1;
+		}
+		if (applied > 0){ this->finishWork(applied); }
+
+		if (!busy){
+			if (active.load() == 0){ return; }
+			me.wakeups.wait(wakeups);
+			continue;
+		}
+
+		for (int expansion = 0; expansion < EXPANSIONS; expansion++){
+			if (me.open.is_empty() || !(me.open.min().key < best.load())){ break; }
+			int    cell_i = me.open.remove_min().value;
+			double next_g = context->g[cell_i] + 1;
+			int    row    = cell_i / cols;
+			int    col    = cell_i % cols;
+			me.expanded  += 1;
+
+			std::array<int, 4> neighbors = {
+				(row > 0)        ? cell_i - cols : -1,
+				(row < rows - 1) ? cell_i + cols : -1,
+				(col > 0)        ? cell_i - 1    : -1,
+				(col < cols - 1) ? cell_i + 1    : -1
+			};
+			for (int next_i: neighbors){
+				if (next_i == -1 || maze.isBlocked(next_i)){ continue; }
+				Message  message{next_i, cell_i, next_g};
+				unsigned owner = this->ownerOf(next_i);
+				if (owner == worker_i){ this->relax(me, message); }
+				else                  { me.outbox[owner].push_back(message); }
+			}
+		}
+		this->send(me);
+		// Lets the owners of what was just sent catch up when there are more
+		// workers than free cores. A worker that runs ahead of the others
+		// expands cells with g values they are about to improve.
+		if (thread_count > 1){ std::this_thread::yield(); }
+
+		if (me.open.is_empty() || !(me.open.min().key < best.load())){
+			busy = false;
+			this->finishWork(1);
+		}
+	}
+}
+
+SearchResult ParallelAStar::search(SearchContext& context, Position start, Position goal){
+	/*************************************************************************
+	 * Seeds the start's owner, runs the workers to termination and traces *
+	 * the path from the goal.                                              *
+	 *************************************************************************/
+	SearchResult result;
+	this->context = &context;
+	this->goal_i  = maze.toIndex(goal);
+
+	context.reset(maze.getSize());
+	if (!maze.connected(start, goal)){
+		context.record(result);
+		return result;
+	}
+
+	for (std::unique_ptr<Worker>& worker: workers){
+		worker->open.reset(maze.getSize());
+		worker->pushed   = 0;
+		worker->expanded = 0;
+	}
+	best.store(NO_PATH);
+	active.store(thread_count);
+
+	int start_i = maze.toIndex(start);
+	this->relax(*workers[this->ownerOf(start_i)], Message{start_i, -1, 0});
+	{
+		std::vector<std::jthread> helpers;
+		for (unsigned worker_i = 1; worker_i < thread_count; worker_i++){
+			helpers.emplace_back(&ParallelAStar::work, this, worker_i);
+		}
+		this->work(0);
+	}
+
+	for (std::unique_ptr<Worker>& worker: workers){
+		context.push_count += worker->pushed;
+		context.stats.expand(worker->expanded);
+	}
+	context.push_count -= 1;	// the start, which the other searches do not count
+	if (best.load() != NO_PATH){
+		result.path_found  = true;
+		result.path_length = context.tracePath(goal_i);
+	}
+	result.push_count = context.push_count;
+	context.record(result);
+	return result;
+}
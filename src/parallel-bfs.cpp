@@ -0,0 +1,148 @@
+#include <array>
+#include <barrier>
+#include <algorithm>
+#include "../incl/parallel-bfs.hpp"
+
+namespace {
+
+	// Frontier cells handed out per claim of next_chunk.
+	const size_t CHUNK = 256;
+
+}
+
+ParallelBfs::ParallelBfs(const Maze& maze, unsigned thread_count):
+	maze         {maze},
+	thread_count {std::max(thread_count, 1u)},
+	visited      ((maze.getSize() + 63) / 64),
+	local_next   (this->thread_count),
+	offsets      (this->thread_count){}
+
+unsigned ParallelBfs::threadCount() const {return thread_count;}
+
+bool ParallelBfs::claim(int cell_i){
+	/*************************************************************************
+	 * Sets the visited bit of cell_i. True only for the one thread that   *
+	 * set it first.                                                       *
+	 *************************************************************************/
+	uint64_t bit = uint64_t(1) << (cell_i % 64);
+	if (visited[cell_i / 64].load(std::memory_order_relaxed) & bit){ return false; }
+	return !(visited[cell_i / 64].fetch_or(bit, std::memory_order_relaxed) & bit);
+}
+
+template<typename DistanceT>
+int ParallelBfs::flood(int source_i, int target_i, std::vector<DistanceT>& distance, std::vector<int>* parent, QueryStats& stats){
+	/*************************************************************************
+	 * Each level runs in two phases, each ending at a barrier whose        *
+	 * completion step runs on one thread:                                  *
+	 *   expand  claim chunks of the frontier, claim neighbors into the    *
+	 *           thread's own buffer; completion sizes next and gives each *
+	 *           buffer its offset.                                        *
+	 *   merge   copy the buffer into next; completion swaps the frontiers *
+	 *           and decides whether to stop.                              *
+	 * Returns the number of cells claimed, the source included.           *
+	 *************************************************************************/
+	for (std::atomic<uint64_t>& word: visited){ word.store(0, std::memory_order_relaxed); }
+	next_chunk.store(0, std::memory_order_relaxed);
+	frontier.assign(1, source_i);
+	claim(source_i);
+	distance[source_i] = 0;
+
+	int    cols    = maze.getCols();
+	int    rows    = maze.getRows();
+	int    level   = 0;
+	bool   done    = (source_i == target_i);
+	size_t claimed = 1;
+
+	auto sized = [&]() noexcept {
+		size_t total = 0;
+		for (unsigned thread_i = 0; thread_i < thread_count; thread_i++){
+			offsets[thread_i] = total;
+			total            += local_next[thread_i].size();
+		}
+		next.resize(total);
+		claimed += total;
+		stats.expand(frontier.size());
+		stats.push(total, total);
+	};
+	auto merged = [&]() noexcept {
+		frontier.swap(next);
+		next_chunk.store(0, std::memory_order_relaxed);
+		level += 1;
+		done   = frontier.empty() || (target_i != -1 && distance[target_i] != -1);
+	};
+	std::barrier expand_done(thread_count, sized);
+	std::barrier merge_done(thread_count, merged);
+
+	auto work = [&](unsigned thread_i){
+		std::vector<int>& found = local_next[thread_i];
+		while (!done){
+			found.clear();
+			DistanceT next_level = level + 1;
+			for (size_t first = next_chunk.fetch_add(CHUNK, std::memory_order_relaxed);
+			     first < frontier.size();
+			     first = next_chunk.fetch_add(CHUNK, std::memory_order_relaxed)){
+				size_t last = std::min(first + CHUNK, frontier.size());
+				for (size_t frontier_i = first; frontier_i < last; frontier_i++){
+					int cell_i = frontier[frontier_i];
+					int row    = cell_i / cols;
+					int col    = cell_i % cols;
+					std::array<int, 4> neighbors = {
+						(row > 0)        ? cell_i - cols : -1,
+						(row < rows - 1) ? cell_i + cols : -1,
+						(col > 0)        ? cell_i - 1    : -1,
+						(col < cols - 1) ? cell_i + 1    : -1
+					};
+					for (int next_i: neighbors){
+						if (next_i == -1 || maze.isBlocked(next_i) || !claim(next_i)){ continue; }
+						distance[next_i] = next_level;
+						if (parent != nullptr){ (*parent)[next_i] = cell_i; }
+						found.push_back(next_i);
+					}
+				}
+			}
+			expand_done.arrive_and_wait();
+			std::copy(found.begin(), found.end(), next.begin() + offsets[thread_i]);
+			merge_done.arrive_and_wait();
+		}
+	};
+
+	{
+		std::vector<std::jthread> helpers;
+		for (unsigned thread_i = 1; thread_i < thread_count; thread_i++){ helpers.emplace_back(work, thread_i); }
+		work(0);
+	}
+	return claimed;
+}
+
+SearchResult ParallelBfs::search(SearchContext& context, Position start, Position goal){
+	/*************************************************************************
+	 * Floods from the start until the goal's level is done, then traces   *
+	 * the path through the parents like the other searches.               *
+	 *************************************************************************/
+	SearchResult result;
+	int          goal_i = maze.toIndex(goal);
+
+	context.reset(maze.getSize());
+	if (!maze.connected(start, goal)){
+		context.record(result);
+		return result;
+	}
+
+	int claimed = this->flood(maze.toIndex(start), goal_i, context.g, &context.parent, context.stats);
+	if (context.g[goal_i] != -1){
+		result.path_found  = true;
+		result.path_length = context.tracePath(goal_i);
+	}
+	context.push_count = claimed - 1;
+	result.push_count  = context.push_count;
+	context.record(result);
+	return result;
+}
+
+std::vector<int> ParallelBfs::distanceField(Position source){
+	std::vector<int> field(maze.getSize(), -1);
+	QueryStats       stats;
+	if (maze.isBlocked(maze.toIndex(source))){ return field; }
+	this->flood(maze.toIndex(source), -1, field, nullptr, stats);
+	return field;
+}
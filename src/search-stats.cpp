@@ -0,0 +1,48 @@
+#include "../incl/search-stats.hpp"
+
+namespace {
+
+	const char* PHASE_NAMES[SearchStats::PHASE_COUNT] = {"setup_ns", "search_ns", "trace_ns"};
+
+}
+
+SearchStats& SearchStats::operator+=(const SearchStats& other){
+	queries            += other.queries;
+	found              += other.found;
+	expanded           += other.expanded;
+	pushed             += other.pushed;
+	stale_pops         += other.stale_pops;
+	sift_steps         += other.sift_steps;
+	peak_frontier       = std::max(peak_frontier, other.peak_frontier);
+	peak_scratch_bytes  = std::max(peak_scratch_bytes, other.peak_scratch_bytes);
+	for (int phase = 0; phase < PHASE_COUNT; phase++){ phase_ns[phase] += other.phase_ns[phase]; }
+	return *this;
+}
+
+void SearchStats::writeJson(std::ostream& out) const{
+	out << "{\"queries\":"            << queries
+	    << ",\"found\":"              << found
+	    << ",\"expanded\":"           << expanded
+	    << ",\"pushed\":"             << pushed
+	    << ",\"stale_pops\":"         << stale_pops
+	    << ",\"sift_steps\":"         << sift_steps
+	    << ",\"peak_frontier\":"      << peak_frontier
+	    << ",\"peak_scratch_bytes\":" << peak_scratch_bytes;
+	for (int phase = 0; phase < PHASE_COUNT; phase++){
+		out << ",\"" << PHASE_NAMES[phase] << "\":" << phase_ns[phase];
+	}
+	out << "}";
+}
+
+void SearchStats::writeCsvHeader(std::ostream& out){
+	out << "queries,found,expanded,pushed,stale_pops,sift_steps,peak_frontier,peak_scratch_bytes";
+	for (int phase = 0; phase < PHASE_COUNT; phase++){ out << "," << PHASE_NAMES[phase]; }
+	out << "\n";
+}
+
+void SearchStats::writeCsv(std::ostream& out) const{
+	out << queries    << "," << found         << "," << expanded           << "," << pushed << ","
+	    << stale_pops << "," << sift_steps    << "," << peak_frontier      << "," << peak_scratch_bytes;
+	for (int phase = 0; phase < PHASE_COUNT; phase++){ out << "," << phase_ns[phase]; }
+	out << "\n";
+}
@@ -0,0 +1,94 @@
+#include <stdexcept>
+#include "../incl/sliced-search.hpp"
+
+SearchTask slicedDfs(const Maze& maze, SearchContext& context, Position start, Position goal){
+	return slicedSearch<StackFrontier, NoHeuristic, FourConnected, VisitOnPush>(
+		maze, context, start, goal, NoHeuristic(maze, goal));
+}
+
+SearchTask slicedBfs(const Maze& maze, SearchContext& context, Position start, Position goal){
+	return slicedSearch<QueueFrontier, NoHeuristic, FourConnected, VisitOnPush>(
+		maze, context, start, goal, NoHeuristic(maze, goal));
+}
+
+SearchTask slicedAStar(const Maze& maze, SearchContext& context, Position start, Position goal){
+	return slicedSearch<HeapFrontier, ManhattanHeuristic, FourConnected, VisitOnPop>(
+		maze, context, start, goal, ManhattanHeuristic(maze, goal));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+SearchScheduler::SearchScheduler(const Maze& maze): maze{maze}{}
+
+int SearchScheduler::submit(Position start, Position goal, TaskFunction search){
+	/*****************************************************************
+	 * Starts the search on a spare context if there is one.         *
+	 *****************************************************************/
+	std::unique_ptr<SearchContext> context;
+	if (spare.empty()){
+		context = std::make_unique<SearchContext>();
+	} else {
+		context = std::move(spare.back());
+		spare.pop_back();
+	}
+	SearchTask task = search(maze, *context, start, goal);
+
+	int ticket = next_ticket++;
+	entries.emplace(ticket, Entry{std::move(context), std::move(task)});
+	running.push_back(ticket);
+	return ticket;
+}
+
+size_t SearchScheduler::tick(SliceBudget slice, std::chrono::microseconds frame){
+	/*****************************************************************
+	 * Takes searches off the front of the queue and puts the ones   *
+	 * that are not done back at the end. Released tickets are       *
+	 * dropped as they come up.                                      *
+	 *****************************************************************/
+	auto   frame_start = std::chrono::steady_clock::now();
+	size_t turns       = running.size();
+
+	while (!running.empty()){
+		if (frame.count() == 0){
+			if (turns == 0){ break; }
+			turns -= 1;
+		} else if (std::chrono::steady_clock::now() - frame_start >= frame){
+			break;
+		}
+
+		int ticket = running.front();
+		running.pop_front();
+		auto entry = entries.find(ticket);
+		if (entry == entries.end()){ continue; }
+		if (!entry->second.task.resume(slice)){ running.push_back(ticket); }
+	}
+	return this->pending();
+}
+
+size_t SearchScheduler::pending() const{
+	size_t count = 0;
+	for (const auto& [ticket, entry]: entries){ count += !entry.task.done(); }
+	return count;
+}
+
+bool SearchScheduler::isDone(int ticket) const{
+	return entries.at(ticket).task.done();
+}
+
+const SearchProgress& SearchScheduler::progress(int ticket) const{
+	return entries.at(ticket).task.progress();
+}
+
+const SearchResult& SearchScheduler::result(int ticket) const{
+	return entries.at(ticket).task.result();
+}
+
+const std::vector<int>& SearchScheduler::path(int ticket) const{
+	return entries.at(ticket).context->path;
+}
+
+void SearchScheduler::release(int ticket){
+	auto entry = entries.find(ticket);
+	if (entry == entries.end()){ return; }
+	spare.push_back(std::move(entry->second.context));
+	entries.erase(entry);
+}
@@ -1,8 +1,30 @@
 #include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <limits>
+#include <chrono>
 #include <ranges>
 #include <gtest/gtest.h>
 #include "../incl/cell.hpp"
 #include "../incl/maze.hpp"
+#include "../incl/batch-query.hpp"
+#include "../incl/indexed-heap.hpp"
+#include "../incl/bucket-queue.hpp"
+#include "../incl/hierarchical-planner.hpp"
+#include "../incl/d-star-lite.hpp"
+#include "../incl/bit-wavefront.hpp"
+#include "../incl/parallel-bfs.hpp"
+#include "../incl/parallel-a-star.hpp"
+#include "../incl/landmarks.hpp"
+#include "../incl/flow-field.hpp"
+#include "../incl/sliced-search.hpp"
+#include "../incl/anytime-a-star.hpp"
+#include "../incl/search_algorithms.hpp"
+#include "../incl/linked-lists.hpp"
+#include "../incl/queue.hpp"
+#include "../incl/priority-queue.hpp"
 
 
 class CellTest : public testing::Test {
@@ -112,7 +134,7 @@ TEST_F(MazeTest, check_all_positions_on_default_maze){
 
 TEST_F(MazeTest, dfs_on_default_maze){
 	EXPECT_EQ(Maze::dfs(&default_maze).has_value(), true);
-	EXPECT_EQ(default_maze.getCell(0,0).getParent(), nullptr);
+	EXPECT_EQ(default_maze.getParent(0,0).has_value(), false);
 }
 
 
@@ -134,12 +156,12 @@ TEST_F(MazeTest, check_dfs_path_on_default_maze){
 	//|   |   |   |   |   |   |   |   | x | * |
 	//| x |   |   |   | x |   | x | x |   | G |
 
-	EXPECT_NE(default_maze.getCell(9,9).getParent(), nullptr);
+	EXPECT_EQ(default_maze.getParent(9,9).has_value(), true);
 }
 
 TEST_F(MazeTest, bfs_on_default_maze){
 	EXPECT_EQ(Maze::bfs(&default_maze).has_value(), true);
-	EXPECT_EQ(default_maze.getCell(0,0).getParent(), nullptr);
+	EXPECT_EQ(default_maze.getParent(0,0).has_value(), false);
 }
 
 TEST_F(MazeTest, check_bfs_path_on_default_maze){
@@ -160,7 +182,7 @@ TEST_F(MazeTest, check_bfs_path_on_default_maze){
 	//|   |   |   |   |   |   |   |   | x | * |
 	//| x |   |   |   | x |   | x | x |   | G |
 
-	EXPECT_NE(default_maze.getCell(9,9).getParent(), nullptr);
+	EXPECT_EQ(default_maze.getParent(9,9).has_value(), true);
 }
 
 //Illegal mazes
@@ -225,31 +247,1293 @@ TEST_F(MazeTest, check_all_positions_on_one_by_two_maze){
 
 TEST_F(MazeTest, dfs_on_one_by_two_maze){
 	EXPECT_EQ(Maze::dfs(&default_maze).has_value(), true);
-	EXPECT_EQ(one_two_maze.getCell(0,0).getParent(), nullptr);
+	EXPECT_EQ(one_two_maze.getParent(0,0).has_value(), false);
 }
 
 TEST_F(MazeTest, a_star_on_default_maze){
 	EXPECT_EQ(Maze::a_star(&default_maze).has_value(), true);
-	EXPECT_EQ(default_maze.getCell(0,0).getParent(), nullptr);
+	EXPECT_EQ(default_maze.getParent(0,0).has_value(), false);
 }
 
 TEST_F(MazeTest, check_a_star_path_on_default_maze){
 	EXPECT_EQ(Maze::a_star(&default_maze).has_value(), true);
 	default_maze.showPath();
-	EXPECT_EQ(default_maze.toString(), "| S |   |   |   |   |   | x | x |   |   |\n| * | * | x |   |   | x |   | x |   |   |\n|   | * | * | * | x |   |   |   |   |   |\n|   |   |   | * | * | * | * | * |   |   |\n|   |   |   |   |   |   | x | * | x |   |\n|   | x |   |   | x | x |   | * | * | * |\n|   |   |   |   | x |   | x |   |   | * |\n|   |   | x |   |   |   |   | x |   | * |\n|   |   |   |   |   |   |   |   | x | * |\n| x |   |   |   | x |   | x | x |   | G |");
+	EXPECT_EQ(default_maze.toString(), "| S |   |   |   |   |   | x | x |   |   |\n| * | * | x |   |   | x |   | x |   |   |\n|   | * | * | * | x |   |   |   |   |   |\n|   |   |   | * | * | * | * | * | * | * |\n|   |   |   |   |   |   | x |   | x | * |\n|   | x |   |   | x | x |   |   |   | * |\n|   |   |   |   | x |   | x |   |   | * |\n|   |   | x |   |   |   |   | x |   | * |\n|   |   |   |   |   |   |   |   | x | * |\n| x |   |   |   | x |   | x | x |   | G |");
 
-	// Maze should print like this:
+	// Maze should print like this (ties on f are broken by the indexed heap,
+	// any shortest path is as good):
 	//
 	//| S |   |   |   |   |   | x | x |   |   |
 	//| * | * | x |   |   | x |   | x |   |   |
 	//|   | * | * | * | x |   |   |   |   |   |
-	//|   |   |   | * | * | * | * | * |   |   |
-	//|   |   |   |   |   |   | x | * | x |   |
-	//|   | x |   |   | x | x |   | * | * | * |
+	//|   |   |   | * | * | * | * | * | * | * |
+	//|   |   |   |   |   |   | x |   | x | * |
+	//|   | x |   |   | x | x |   |   |   | * |
 	//|   |   |   |   | x |   | x |   |   | * |
 	//|   |   | x |   |   |   |   | x |   | * |
 	//|   |   |   |   |   |   |   |   | x | * |
 	//| x |   |   |   | x |   | x | x |   | G |
 
-	EXPECT_NE(default_maze.getCell(9,9).getParent(), nullptr);
+	EXPECT_EQ(default_maze.getParent(9,9).has_value(), true);
+}
+
+// --- Wide mazes (more than 10 columns)
+
+TEST(WideMazeTest, bfs_on_open_wide_maze){
+	Maze open_maze(Position(0,0), Position(19,24), 20, 25, 7, 0.0);
+	EXPECT_EQ(Maze::bfs(&open_maze).has_value(), true);
+	EXPECT_EQ(open_maze.path_length, 19+24-1);
+}
+
+TEST(WideMazeTest, a_star_on_open_wide_maze){
+	Maze open_maze(Position(0,0), Position(19,24), 20, 25, 7, 0.0);
+	EXPECT_EQ(Maze::a_star(&open_maze).has_value(), true);
+	EXPECT_EQ(open_maze.path_length, 19+24-1);
+}
+
+// --- Read-only queries
+
+TEST_F(MazeTest, queries_do_not_modify_maze){
+	std::string   before = default_maze.toString();
+	SearchContext first;
+	SearchContext second;
+
+	SearchResult bfs_result  = Maze::bfs(default_maze, first, Position(0,0), Position(9,9));
+	SearchResult star_result = Maze::a_star(default_maze, second, Position(9,9), Position(0,0));
+
+	EXPECT_EQ(bfs_result.path_found, true);
+	EXPECT_EQ(star_result.path_found, true);
+	EXPECT_EQ(bfs_result.path_length, star_result.path_length);
+	EXPECT_EQ(first.path.front(), 0);
+	EXPECT_EQ(first.path.back(), 99);
+	EXPECT_EQ(default_maze.toString(), before);
+}
+
+TEST_F(MazeTest, start_equal_to_goal_has_length_zero){
+	typedef SearchResult (*Query)(const Maze&, SearchContext&, Position, Position);
+	std::vector<Query> searches = {
+		&Maze::dfs, &Maze::bfs, &Maze::a_star, &Maze::dijkstra, &Maze::jps,
+		&Maze::bidirectional_bfs, &Maze::bidirectional_a_star};
+	SearchContext context;
+	Position      cell(3, 3);
+	for (Query search: searches){
+		SearchResult result = search(default_maze, context, cell, cell);
+		EXPECT_TRUE(result.path_found);
+		EXPECT_EQ(result.path_length, 0);
+		EXPECT_EQ(context.path, std::vector<int>{default_maze.toIndex(cell)});
+	}
+
+	HierarchicalPlanner planner(default_maze);
+	EXPECT_EQ(planner.search(context, cell, cell).path_length, 0);
+	FlowField field(default_maze, cell);
+	EXPECT_EQ(field.search(context, cell).path_length, 0);
+	DStarLite d_star(default_maze, cell, cell);
+	EXPECT_EQ(d_star.replan(context).path_length, 0);
+}
+
+TEST(BatchQueryTest, batch_matches_single_queries){
+	Maze maze(Position(0,0), Position(29,29), 30, 30, 3, 0.3);
+	std::vector<PathQuery> queries;
+	for (int i = 0; i < 50; i++){
+		queries.push_back(PathQuery(Position(i%30, (i*7)%30), Position((i*13)%30, 29-(i%30))));
+	}
+
+	BatchQueryEngine engine(maze, 4);
+	std::vector<SearchResult> results = engine.run(queries);
+	// A second batch on the same pool reuses the workers.
+	std::vector<SearchResult> again   = engine.run(queries);
+
+	SearchContext context;
+	for (int i = 0; i < queries.size(); i++){
+		SearchResult expected = Maze::a_star(maze, context, queries[i].start, queries[i].goal);
+		EXPECT_EQ(results[i].path_found,  expected.path_found);
+		EXPECT_EQ(results[i].path_length, expected.path_length);
+		EXPECT_EQ(results[i].push_count,  expected.push_count);
+		EXPECT_EQ(again[i].path_length,   expected.path_length);
+	}
+}
+
+//					****** HEAP TESTS ******
+
+TEST(IndexedHeapTest, removes_in_key_order){
+	IndexedHeap<double> heap(20);
+	for (int item = 0; item < 20; item++){ heap.insert((item*7)%20, item); }
+	for (int expected = 0; expected < 20; expected++){
+		EXPECT_EQ(heap.remove_min().key, expected);
+	}
+	EXPECT_EQ(heap.is_empty(), true);
+}
+
+TEST(IndexedHeapTest, decrease_key_and_remove){
+	IndexedHeap<double> heap(10);
+	heap.insert(5.5, 1);
+	heap.insert(3.0, 2);
+	heap.insert(9.0, 3);
+	heap.decrease_key(3, 1.5);
+	heap.remove(2);
+	EXPECT_EQ(heap.contains(2), false);
+	EXPECT_EQ(heap.key_of(3), 1.5);
+	EXPECT_EQ(heap.remove_min().value, 3);
+	heap.update(1, 8.0);
+	EXPECT_EQ(heap.min().key, 8.0);
+	EXPECT_THROW(heap.insert(1.0, 1), std::invalid_argument);
+}
+
+TEST(IndexedHeapTest, decrease_key_with_a_larger_key_keeps_order){
+	IndexedHeap<double> heap(10);
+	for (int item = 0; item < 10; item++){ heap.insert(item, item); }
+	heap.decrease_key(0, 20.0);
+	heap.decrease_key(4, 0.5);
+	EXPECT_EQ(heap.key_of(0), 20.0);
+	std::vector<int> order;
+	while (!heap.is_empty()){ order.push_back(heap.remove_min().value); }
+	EXPECT_EQ(order, (std::vector<int>{4, 1, 2, 3, 5, 6, 7, 8, 9, 0}));
+}
+
+TEST(PriorityQueueTest, fractional_keys_are_not_truncated){
+	PriorityQueue<double, int> queue;
+	queue.insert(1.0, 0);
+	queue.insert(1.9, 1);
+	queue.insert(1.5, 2);
+	queue.insert(0.5, 3);
+	EXPECT_EQ(queue.remove_min().value, 3);
+	EXPECT_EQ(queue.remove_min().value, 0);
+	EXPECT_EQ(queue.remove_min().value, 2);
+	EXPECT_EQ(queue.remove_min().value, 1);
+}
+
+TEST(IndexedHeapTest, a_star_matches_bfs_length){
+	SearchContext context;
+	for (int seed = 0; seed < 20; seed++){
+		Maze maze(Position(0,0), Position(24,24), 25, 25, seed, 0.3);
+		SearchResult expected = Maze::bfs(maze, context, Position(0,0), Position(24,24));
+		SearchResult result   = Maze::a_star(maze, context, Position(0,0), Position(24,24));
+		EXPECT_EQ(result.path_found,  expected.path_found);
+		EXPECT_EQ(result.path_length, expected.path_length);
+	}
+}
+
+TEST(BucketQueueTest, deepest_first_within_a_key){
+	BucketQueue queue(10);
+	queue.insert(4, 1, 0);
+	queue.insert(2, 0, 1);
+	queue.insert(4, 3, 2);
+	queue.insert(4, 2, 3);
+	queue.update(1, 5, 0);
+	EXPECT_EQ(queue.remove_min().value, 2);
+	EXPECT_EQ(queue.remove_min().value, 3);
+	EXPECT_EQ(queue.remove_min().value, 0);
+	EXPECT_EQ(queue.remove_min().key,   5);
+	EXPECT_EQ(queue.is_empty(), true);
+}
+
+TEST(BucketQueueTest, depths_are_bounded_by_keys){
+	// Ties are split by key - depth, so a depth may not be above its key.
+	BucketQueue queue(4);
+	EXPECT_THROW(queue.insert(1, 2, 0), std::invalid_argument);
+	queue.insert(3, 3, 0);
+	queue.insert(3, 0, 1);
+	queue.insert(3, 1, 2);
+	EXPECT_EQ(queue.remove_min().value, 0);
+	EXPECT_EQ(queue.remove_min().value, 2);
+	EXPECT_EQ(queue.remove_min().value, 1);
+}
+
+TEST(BucketQueueTest, bucket_frontier_matches_heap){
+	SearchContext context;
+	for (int seed = 0; seed < 20; seed++){
+		Maze maze(Position(0,0), Position(29,19), 30, 20, seed, 0.3);
+		SearchResult heap    = Maze::a_star(maze, context, Position(0,0), Position(29,19), Maze::Frontier::HEAP);
+		SearchResult buckets = Maze::a_star(maze, context, Position(0,0), Position(29,19), Maze::Frontier::BUCKETS);
+		SearchResult flat    = Maze::dijkstra(maze, context, Position(0,0), Position(29,19), Maze::Frontier::BUCKETS);
+		EXPECT_EQ(buckets.path_found,  heap.path_found);
+		EXPECT_EQ(buckets.path_length, heap.path_length);
+		EXPECT_EQ(flat.path_length,    heap.path_length);
+	}
+}
+
+//					****** JUMP POINT SEARCH TESTS ******
+
+TEST(JumpPointTest, jps_matches_a_star_length){
+	SearchContext context;
+	for (int seed = 0; seed < 40; seed++){
+		Maze maze(Position(1,2), Position(27,33), 30, 35, seed, 0.1 + (seed%4)*0.1);
+		SearchResult expected = Maze::a_star(maze, context, Position(1,2), Position(27,33));
+		SearchResult result   = Maze::jps(maze, context, Position(1,2), Position(27,33));
+		EXPECT_EQ(result.path_found,  expected.path_found);
+		EXPECT_EQ(result.path_length, expected.path_length);
+		if (result.path_found){
+			EXPECT_EQ(context.path.size(), result.path_length + 2);
+			for (int i = 1; i < context.path.size(); i++){
+				Position from = maze.toPosition(context.path[i-1]);
+				Position to   = maze.toPosition(context.path[i]);
+				EXPECT_EQ(maze.manhattan(from, to), 1);
+				EXPECT_EQ(maze.isBlocked(context.path[i]), false);
+			}
+		}
+	}
+}
+
+TEST(JumpPointTest, jps_pushes_less_on_open_grid){
+	Maze         maze(Position(0,0), Position(49,49), 50, 50, 1, 0.0);
+	SearchContext context;
+	SearchResult expected = Maze::a_star(maze, context, Position(0,0), Position(49,49));
+	SearchResult result   = Maze::jps(maze, context, Position(0,0), Position(49,49));
+	EXPECT_EQ(result.path_length, expected.path_length);
+	EXPECT_LT(result.push_count, expected.push_count);
+}
+
+TEST_F(MazeTest, jps_on_default_maze){
+	EXPECT_EQ(Maze::jps(&default_maze).has_value(), true);
+	EXPECT_EQ(default_maze.path_length, 17);
+	EXPECT_EQ(default_maze.getParent(9,9).has_value(), true);
+}
+
+//					****** BIDIRECTIONAL SEARCH TESTS ******
+
+TEST(BidirectionalTest, bidirectional_matches_bfs_length){
+	SearchContext context;
+	for (int seed = 0; seed < 40; seed++){
+		Maze maze(Position(3,0), Position(20,31), 25, 32, seed, 0.15 + (seed%3)*0.1);
+		SearchResult expected = Maze::bfs(maze, context, Position(3,0), Position(20,31));
+		SearchResult bi_bfs   = Maze::bidirectional_bfs(maze, context, Position(3,0), Position(20,31));
+		EXPECT_EQ(bi_bfs.path_found,  expected.path_found);
+		EXPECT_EQ(bi_bfs.path_length, expected.path_length);
+		if (bi_bfs.path_found){
+			EXPECT_EQ(context.path.front(), maze.toIndex(Position(3,0)));
+			EXPECT_EQ(context.path.back(),  maze.toIndex(Position(20,31)));
+			for (int i = 1; i < context.path.size(); i++){
+				EXPECT_EQ(maze.manhattan(maze.toPosition(context.path[i-1]), maze.toPosition(context.path[i])), 1);
+			}
+		}
+		SearchResult bi_star  = Maze::bidirectional_a_star(maze, context, Position(3,0), Position(20,31));
+		EXPECT_EQ(bi_star.path_found,  expected.path_found);
+		EXPECT_EQ(bi_star.path_length, expected.path_length);
+	}
+}
+
+TEST_F(MazeTest, bidirectional_on_default_maze){
+	EXPECT_EQ(Maze::bidirectional_bfs(&default_maze).has_value(), true);
+	EXPECT_EQ(default_maze.path_length, 17);
+	EXPECT_EQ(Maze::bidirectional_a_star(&default_maze).has_value(), true);
+	EXPECT_EQ(default_maze.path_length, 17);
+	EXPECT_EQ(default_maze.getParent(9,9).has_value(), true);
+}
+
+//					****** HIERARCHICAL PLANNER TESTS ******
+
+void expectValidPath(Maze& maze, const std::vector<int>& path, Position start, Position goal){
+	ASSERT_EQ(path.empty(), false);
+	EXPECT_EQ(path.front(), maze.toIndex(start));
+	EXPECT_EQ(path.back(),  maze.toIndex(goal));
+	for (int i = 1; i < path.size(); i++){
+		EXPECT_EQ(maze.manhattan(maze.toPosition(path[i-1]), maze.toPosition(path[i])), 1);
+		EXPECT_EQ(maze.isBlocked(path[i]), false);
+	}
+}
+
+TEST(HierarchicalPlannerTest, finds_the_same_paths_as_bfs){
+	SearchContext context;
+	SearchContext bfs_context;
+	for (int seed = 0; seed < 20; seed++){
+		Maze maze(Position(0,0), Position(44,52), 45, 53, seed, 0.25);
+		HierarchicalPlanner planner(maze, 8);
+		for (int query = 0; query < 10; query++){
+			Position start((seed*7 + query*11) % 45, (query*17) % 53);
+			Position goal((query*5) % 45, (seed*3 + query*13) % 53);
+			if (maze.isBlocked(maze.toIndex(start)) || maze.isBlocked(maze.toIndex(goal))){continue;}
+			if (maze.toIndex(start) == maze.toIndex(goal)){continue;}
+
+			SearchResult expected = Maze::bfs(maze, bfs_context, start, goal);
+			SearchResult result   = planner.search(context, start, goal);
+			EXPECT_EQ(result.path_found, expected.path_found);
+			if (result.path_found){
+				EXPECT_GE(result.path_length, expected.path_length);
+				expectValidPath(maze, context.path, start, goal);
+			}
+		}
+	}
+}
+
+TEST(HierarchicalPlannerTest, edits_rebuild_only_touched_clusters){
+	Maze                maze(Position(0,0), Position(63,63), 64, 64, 2, 0.2);
+	HierarchicalPlanner planner(maze, 16);
+	SearchContext       context;
+	SearchContext       bfs_context;
+	EXPECT_EQ(planner.buildCount(), 16);
+
+	// A cell away from every border only touches its own cluster.
+	if (maze.isBlocked(maze.toIndex(Position(5,5)))){ maze.markAsEmpty(5,5); }
+	else                                            { maze.markAsBlocked(5,5); }
+	planner.refresh();
+	EXPECT_EQ(planner.buildCount(), 17);
+
+	// Wall off the middle of the map one cell at a time, a corner included.
+	for (int col = 0; col < 63; col++){
+		if (!maze.isBlocked(maze.toIndex(Position(31, col)))){ maze.markAsBlocked(31, col); }
+	}
+	maze.markAsEmpty(31, 20);
+
+	int before = planner.buildCount();
+	SearchResult result   = planner.search(context, Position(0,0), Position(63,63));
+	SearchResult expected = Maze::bfs(maze, bfs_context, Position(0,0), Position(63,63));
+	EXPECT_LE(planner.buildCount() - before, 12);
+	EXPECT_EQ(result.path_found, expected.path_found);
+	if (result.path_found){ expectValidPath(maze, context.path, Position(0,0), Position(63,63)); }
+}
+
+TEST(HierarchicalPlannerTest, refreshed_planner_matches_a_fresh_one){
+	Maze                maze(Position(0,0), Position(47,47), 48, 48, 9, 0.25);
+	HierarchicalPlanner planner(maze, 8);
+	SearchContext       context;
+	SearchContext       fresh_context;
+	std::mt19937        rng(8);
+	for (int round = 0; round < 30; round++){
+		for (int edit = 0; edit < 5; edit++){
+			int row = rng() % 48;
+			int col = rng() % 48;
+			if (rng() % 2){ maze.markAsBlocked(row, col); }
+			else          { maze.markAsEmpty(row, col); }
+		}
+		Position start(rng() % 48, rng() % 48);
+		Position goal(rng() % 48, rng() % 48);
+		if (maze.isBlocked(maze.toIndex(start)) || maze.isBlocked(maze.toIndex(goal))){ continue; }
+
+		HierarchicalPlanner fresh(maze, 8);
+		SearchResult        result   = planner.search(context, start, goal);
+		SearchResult        expected = fresh.search(fresh_context, start, goal);
+		EXPECT_EQ(planner.entranceCount(), fresh.entranceCount());
+		EXPECT_EQ(result.path_found, expected.path_found);
+		EXPECT_EQ(result.path_length, expected.path_length);
+		if (result.path_found){ expectValidPath(maze, context.path, start, goal); }
+	}
+}
+
+//					****** D* LITE TESTS ******
+
+TEST(DStarLiteTest, replans_after_edits_like_a_fresh_search){
+	SearchContext context;
+	SearchContext bfs_context;
+	for (int seed = 0; seed < 10; seed++){
+		Maze      maze(Position(0,0), Position(39,39), 40, 40, seed, 0.25);
+		DStarLite planner(maze, Position(0,0), Position(39,39));
+		std::mt19937 rng(seed);
+
+		for (int round = 0; round < 5; round++){
+			SearchResult expected = Maze::bfs(maze, bfs_context, Position(0,0), Position(39,39));
+			SearchResult result   = planner.replan(context);
+			EXPECT_EQ(result.path_found,  expected.path_found);
+			EXPECT_EQ(result.path_length, expected.path_length);
+			if (result.path_found){ expectValidPath(maze, context.path, Position(0,0), Position(39,39)); }
+			EXPECT_EQ(result.stats.queries, 1);
+			EXPECT_EQ(result.stats.found, result.path_found);
+			EXPECT_EQ(result.stats.pushed, result.push_count);
+
+			for (int edit = 0; edit < 8; edit++){
+				int row = 1 + rng() % 38;
+				int col = 1 + rng() % 38;
+				if (rng() % 2){ maze.markAsBlocked(row, col); }
+				else          { maze.markAsEmpty(row, col); }
+			}
+		}
+	}
+}
+
+TEST(DStarLiteTest, replan_without_a_path_records_fresh_stats){
+	Maze          maze(Position(0,0), Position(9,9), 10, 10, 1, 0.0);
+	SearchContext context;
+	Maze::bfs(maze, context, Position(0,0), Position(9,9));
+	for (int col = 0; col < 10; col++){ maze.markAsBlocked(5, col); }
+
+	DStarLite    planner(maze, Position(0,0), Position(9,9));
+	SearchResult result = planner.replan(context);
+	EXPECT_FALSE(result.path_found);
+	EXPECT_EQ(result.stats.queries, 1);
+	EXPECT_EQ(result.stats.expanded, 0);
+	EXPECT_EQ(context.stats.expanded, 0);
+}
+
+TEST(DStarLiteTest, small_edits_cost_less_than_the_first_plan){
+	Maze          maze(Position(0,0), Position(99,99), 100, 100, 4, 0.2);
+	DStarLite     planner(maze, Position(0,0), Position(99,99));
+	SearchContext context;
+
+	SearchResult first = planner.replan(context);
+	ASSERT_EQ(first.path_found, true);
+
+	// Block a cell in the middle of the current path, then move the start
+	// one step along it.
+	Position on_path = maze.toPosition(context.path[context.path.size()/2]);
+	Position next    = maze.toPosition(context.path[1]);
+	maze.markAsBlocked(on_path.row, on_path.col);
+	planner.moveStart(next);
+
+	SearchContext bfs_context;
+	SearchResult  repaired = planner.replan(context);
+	SearchResult  expected = Maze::bfs(maze, bfs_context, next, Position(99,99));
+	EXPECT_EQ(repaired.path_length, expected.path_length);
+	EXPECT_LT(repaired.push_count, first.push_count);
+}
+
+//					****** COMPONENT TESTS ******
+
+TEST(ComponentTest, labels_follow_edits){
+	SearchContext context;
+	for (int seed = 0; seed < 10; seed++){
+		Maze         maze(Position(0,0), Position(19,19), 20, 20, seed, 0.35);
+		std::mt19937 rng(seed);
+
+		for (int round = 0; round < 40; round++){
+			int row = rng() % 20;
+			int col = rng() % 20;
+			if ((row == 0 && col == 0) || (row == 19 && col == 19)){ continue; }
+			if (rng() % 2){ maze.markAsBlocked(row, col); }
+			else          { maze.markAsEmpty(row, col); }
+
+			Position from(rng() % 20, rng() % 20);
+			Position to(rng() % 20, rng() % 20);
+			if (maze.isBlocked(maze.toIndex(from))){ continue; }
+			maze.markAsEmpty(to.row, to.col);
+			bool found = Maze::bfs(maze, context, from, to).path_found || (from.row == to.row && from.col == to.col);
+			EXPECT_EQ(maze.connected(from, to), found);
+		}
+	}
+}
+
+TEST(ComponentTest, unreachable_queries_return_before_searching){
+	// The goal's only free neighbors get blocked, so it is cut off.
+	Maze maze(Position(0,0), Position(9,9), 10, 10, 1, 0.0);
+	int  components = maze.componentCount();
+	maze.markAsBlocked(8, 9);
+	maze.markAsBlocked(9, 8);
+	EXPECT_EQ(maze.componentCount(), components + 1);
+	EXPECT_EQ(maze.connected(Position(0,0), Position(9,9)), false);
+
+	typedef SearchResult (*Query)(const Maze&, SearchContext&, Position, Position);
+	std::vector<Query> searches = {&Maze::bfs, &Maze::dfs, &Maze::jps, &Maze::bidirectional_bfs};
+	SearchContext      context;
+	for (Query search: searches){
+		SearchResult result = search(maze, context, Position(0,0), Position(9,9));
+		EXPECT_EQ(result.path_found, false);
+		EXPECT_EQ(result.push_count, 0);
+	}
+
+	maze.markAsEmpty(8, 9);
+	EXPECT_EQ(maze.componentCount(), components);
+	EXPECT_EQ(Maze::a_star(maze, context, Position(0,0), Position(9,9)).path_length, 17);
+}
+
+TEST(ComponentTest, edits_keep_labels_exact_and_recycle_them){
+	// After every edit the labels must split the free cells exactly like a
+	// fresh labeling, with matching sizes.
+	Maze         maze(Position(0,0), Position(24,24), 25, 25, 9, 0.3);
+	std::mt19937 rng(10);
+	for (int round = 0; round < 400; round++){
+		int row = rng() % 25;
+		int col = rng() % 25;
+		if ((row == 0 && col == 0) || (row == 24 && col == 24)){ continue; }
+		if (rng() % 3){ maze.markAsBlocked(row, col); }
+		else          { maze.markAsEmpty(row, col); }
+
+		Maze fresh = maze;
+		fresh.labelComponents();
+		ASSERT_EQ(maze.componentCount(), fresh.componentCount());
+		std::vector<int> fresh_to_label(fresh.labelBound(), -1);
+		std::vector<int> sizes(maze.labelBound(), 0);
+		for (int cell_i = 0; cell_i < maze.getSize(); cell_i++){
+			int label       = maze.componentOf(maze.toPosition(cell_i));
+			int fresh_label = fresh.componentOf(maze.toPosition(cell_i));
+			ASSERT_EQ(label == -1, fresh_label == -1);
+			if (label == -1){ continue; }
+			ASSERT_LT(label, maze.labelBound());
+			if (fresh_to_label[fresh_label] == -1){ fresh_to_label[fresh_label] = label; }
+			ASSERT_EQ(fresh_to_label[fresh_label], label);
+			sizes[label] += 1;
+		}
+		for (int label = 0; label < maze.labelBound(); label++){
+			ASSERT_EQ(maze.componentSize(label), sizes[label]);
+		}
+	}
+
+	// Cutting (0,5) off and joining it back reuses the same label.
+	Maze open_maze(Position(0,0), Position(9,9), 10, 10, 1, 0.0);
+	open_maze.markAsBlocked(0, 4);
+	open_maze.markAsBlocked(1, 5);
+	int bound = open_maze.labelBound();
+	for (int round = 0; round < 100; round++){
+		open_maze.markAsBlocked(0, 6);
+		open_maze.markAsEmpty(0, 6);
+	}
+	EXPECT_EQ(open_maze.labelBound(), bound + 1);
+	EXPECT_EQ(open_maze.componentCount(), 1);
+}
+
+//					****** SEARCH ENGINE TESTS ******
+
+TEST(SearchEngineTest, instantiations_agree_with_the_maze_searches){
+	SearchContext context;
+	for (int seed = 0; seed < 20; seed++){
+		Maze maze(Position(0,0), Position(29,29), 30, 30, seed, 0.3);
+		int  expected = Maze::bfs(maze, context, Position(0,0), Position(29,29)).path_length;
+
+		SearchResult a_star   = gridSearch<BucketFrontier, ManhattanHeuristic, FourConnected, VisitOnPop>(maze, context, Position(0,0), Position(29,29));
+		EXPECT_EQ(a_star.path_length, expected);
+		SearchResult dijkstra = gridSearch<HeapFrontier, NoHeuristic, FourConnected, VisitOnPop>(maze, context, Position(0,0), Position(29,29));
+		EXPECT_EQ(dijkstra.path_length, expected);
+	}
+}
+
+// Pushes a cell again on every improvement and leaves the old entry in place.
+class LazyHeapFrontier{
+	private:
+		std::vector<std::pair<double, int>> entries;
+		static bool later(const std::pair<double, int>& a, const std::pair<double, int>& b){ return a.first > b.first; }
+	public:
+		LazyHeapFrontier(SearchContext&){}
+		void reset(size_t)                      { entries.clear(); }
+		void push(int cell_i, double f, double) { entries.emplace_back(f, cell_i); std::push_heap(entries.begin(), entries.end(), later); }
+		int  pop()                              { std::pop_heap(entries.begin(), entries.end(), later); int cell_i = entries.back().second; entries.pop_back(); return cell_i; }
+		bool is_empty()                         { return entries.empty(); }
+		size_t size()                           { return entries.size(); }
+};
+
+TEST(SearchEngineTest, visit_on_pop_skips_cells_popped_again){
+	SearchContext context;
+	uint64_t      stale_pops = 0;
+	for (int seed = 0; seed < 20; seed++){
+		Maze maze(Position(0,0), Position(29,29), 30, 30, seed, 0.3);
+		bool reachable = Maze::bfs(maze, context, Position(0,0), Position(29,29)).path_found;
+
+		SearchResult lazy = gridSearch<LazyHeapFrontier, NoHeuristic, EightConnected, VisitOnPop>(maze, context, Position(0,0), Position(29,29));
+		double       cost = context.g[maze.toIndex(Position(29,29))];
+		EXPECT_EQ(lazy.path_found, reachable);
+		gridSearch<HeapFrontier, NoHeuristic, EightConnected, VisitOnPop>(maze, context, Position(0,0), Position(29,29));
+		EXPECT_NEAR(cost, context.g[maze.toIndex(Position(29,29))], 1e-9);
+		stale_pops += lazy.stats.stale_pops;
+	}
+	EXPECT_GT(stale_pops, 0);
+}
+
+TEST(SearchEngineTest, eight_connected_search){
+	SearchContext context;
+	Maze          open_maze(Position(0,0), Position(9,9), 10, 10, 1, 0.0);
+	SearchResult  diagonal = gridSearch<HeapFrontier, OctileHeuristic, EightConnected, VisitOnPop>(open_maze, context, Position(0,0), Position(9,9));
+	EXPECT_EQ(diagonal.path_length, 8);
+	EXPECT_DOUBLE_EQ(context.g[open_maze.toIndex(Position(9,9))], 9 * M_SQRT2);
+
+	// The octile heuristic must not change the cost Dijkstra finds.
+	for (int seed = 0; seed < 20; seed++){
+		Maze maze(Position(0,0), Position(29,29), 30, 30, seed, 0.3);
+		gridSearch<HeapFrontier, NoHeuristic, EightConnected, VisitOnPop>(maze, context, Position(0,0), Position(29,29));
+		double expected = context.g[maze.toIndex(Position(29,29))];
+		gridSearch<HeapFrontier, OctileHeuristic, EightConnected, VisitOnPop>(maze, context, Position(0,0), Position(29,29));
+		EXPECT_NEAR(context.g[maze.toIndex(Position(29,29))], expected, 1e-9);
+	}
+}
+
+//					****** QUEUE AND LIST TESTS ******
+
+TEST(QueueTest, keeps_fifo_order_across_wraparound_and_growth){
+	Queue<int> queue;
+	int        next_in  = 0;
+	int        next_out = 0;
+	for (int round = 0; round < 50; round++){
+		for (int i = 0; i < round % 7 + 3; i++){ queue.push(next_in++); }
+		for (int i = 0; i < round % 5 + 1 && !queue.isEmpty(); i++){ EXPECT_EQ(queue.pop(), next_out++); }
+	}
+	EXPECT_EQ(queue.size(), next_in - next_out);
+	while (!queue.isEmpty()){ EXPECT_EQ(queue.pop(), next_out++); }
+	EXPECT_THROW(queue.pop(), std::length_error);
+
+	size_t capacity = queue.capacity();
+	queue.clear();
+	for (int i = 0; i < (int)capacity; i++){ queue.push(i); }
+	EXPECT_EQ(queue.capacity(), capacity);
+	EXPECT_EQ(queue.top(), 0);
+}
+
+TEST(LinkedListTest, pooled_nodes_are_reused){
+	NodePool<int>   pool;
+	LinkedList<int> list(&pool);
+	for (int i = 0; i < 1000; i++){ list.addRight(i); }
+	size_t warm_capacity = pool.capacity();
+
+	for (int round = 0; round < 10; round++){
+		for (int i = 0; i < 1000; i++){ list.removeLeft(); }
+		for (int i = 0; i < 1000; i++){ list.addRight(i); }
+	}
+	EXPECT_EQ(pool.capacity(), warm_capacity);
+
+	LinkedList<int> copy(list);
+	copy.removeLeft();
+	EXPECT_EQ(copy.getSize(), 999);
+	EXPECT_EQ(list.getSize(), 1000);
+	EXPECT_EQ(list.removeLeft(), 0);
+	EXPECT_EQ(copy.removeLeft(), 1);
+}
+
+//					****** GENERATION TESTS ******
+
+TEST(GenerationTest, seeded_mazes_are_reproducible){
+	Maze first(Position(0,0), Position(49,49), 50, 50, 7, 0.3);
+	Maze second(Position(0,0), Position(49,49), 50, 50, 7, 0.3);
+	int  blocked = 0;
+	for (int cell_i = 0; cell_i < first.getSize(); cell_i++){
+		EXPECT_EQ(first.isBlocked(cell_i), second.isBlocked(cell_i));
+		blocked += first.isBlocked(cell_i);
+	}
+	EXPECT_EQ(blocked, 750);
+	EXPECT_EQ(first.getCell(0,0).getContents(), Contents::START);
+	EXPECT_EQ(first.getCell(49,49).getContents(), Contents::GOAL);
+	EXPECT_EQ(first.getCell(20,30).getPosition().col, 30);
+}
+
+TEST(GenerationTest, tiled_output_does_not_depend_on_thread_count){
+	Maze one   = Maze::tiled(Position(0,0), Position(299,199), 300, 200, 42, 0.3, 1);
+	Maze many  = Maze::tiled(Position(0,0), Position(299,199), 300, 200, 42, 0.3, 7);
+	Maze other = Maze::tiled(Position(0,0), Position(299,199), 300, 200, 43, 0.3, 7);
+	int  blocked    = 0;
+	int  difference = 0;
+	for (int cell_i = 0; cell_i < one.getSize(); cell_i++){
+		ASSERT_EQ(one.isBlocked(cell_i), many.isBlocked(cell_i));
+		blocked    += one.isBlocked(cell_i);
+		difference += one.isBlocked(cell_i) != other.isBlocked(cell_i);
+	}
+	EXPECT_NEAR(blocked / 60000.0, 0.3, 0.01);
+	EXPECT_GT(difference, 0);
+	EXPECT_EQ(many.getCell(299,199).getContents(), Contents::GOAL);
+	EXPECT_EQ(many.componentOf(Position(0,0)) != -1, true);
+}
+
+TEST(GenerationTest, grid_stores_one_byte_per_cell){
+	static_assert(sizeof(Contents) == 1);
+	Maze maze(Position(0,0), Position(9,9), 10, 10, 1, 0.2);
+
+	// getCell gives a copy built from the byte and the index.
+	Cell copy = maze.getCell(3, 4);
+	EXPECT_EQ(copy.getPosition().row, 3);
+	EXPECT_EQ(copy.getPosition().col, 4);
+	copy.markAsBlocked();
+	maze.markAsEmpty(3, 4);
+	EXPECT_EQ(maze.isBlocked(maze.toIndex(Position(3,4))), false);
+
+	std::optional<Cell*> goal = Maze::bfs(&maze);
+	ASSERT_EQ(goal.has_value(), true);
+	EXPECT_EQ(goal.value()->isGoal(), true);
+	EXPECT_EQ(goal.value()->getPosition().row, 9);
+}
+
+//					****** MAZE FILE TESTS ******
+
+TEST(MazeFileTest, opened_maze_matches_the_saved_one){
+	std::string   path = testing::TempDir() + "maze_file_test.bin";
+	Maze          saved(Position(2,3), Position(40,57), 45, 60, 11, 0.3);
+	SearchContext context;
+	saved.save(path);
+
+	Maze opened = Maze::open(path);
+	ASSERT_EQ(opened.getRows(), 45);
+	ASSERT_EQ(opened.getCols(), 60);
+	EXPECT_EQ(opened.hasComponents(), false);
+	for (int cell_i = 0; cell_i < saved.getSize(); cell_i++){
+		ASSERT_EQ(opened.isBlocked(cell_i), saved.isBlocked(cell_i));
+	}
+	EXPECT_EQ(
+		Maze::a_star(opened, context, Position(2,3), Position(40,57)).path_length,
+		Maze::a_star(saved,  context, Position(2,3), Position(40,57)).path_length);
+
+	// Edits are copy-on-write: the file keeps the saved maze.
+	opened.labelComponents();
+	opened.markAsBlocked(2, 4);
+	EXPECT_EQ(opened.isBlocked(opened.toIndex(Position(2,4))), true);
+	Maze reopened = Maze::open(path);
+	EXPECT_EQ(reopened.isBlocked(reopened.toIndex(Position(2,4))), saved.isBlocked(saved.toIndex(Position(2,4))));
+
+	// A copy does not share the mapping.
+	Maze copy = reopened;
+	copy.markAsBlocked(2, 4);
+	EXPECT_EQ(reopened.isBlocked(reopened.toIndex(Position(2,4))), saved.isBlocked(saved.toIndex(Position(2,4))));
+	std::remove(path.c_str());
+}
+
+TEST(MazeFileTest, rejects_files_that_are_not_mazes){
+	std::string path = testing::TempDir() + "not_a_maze.bin";
+	std::ofstream(path) << std::string(100, 'x');
+	EXPECT_THROW(Maze::open(path), std::invalid_argument);
+	std::remove(path.c_str());
+	EXPECT_THROW(Maze::open(path), std::runtime_error);
+}
+
+//					****** MAZE TEXT TESTS ******
+
+TEST(MazeTextTest, round_trips_both_formats){
+	Maze maze(Position(3,0), Position(17,24), 20, 25, 5, 0.3);
+	for (Maze::TextFormat format: {Maze::TextFormat::BOXED, Maze::TextFormat::COMPACT}){
+		std::ostringstream out;
+		maze.writeText(out, format);
+		ASSERT_EQ(out.str().size(), maze.textSize(format));
+
+		std::string buffer(maze.textSize(format), '?');
+		maze.writeText(buffer.data(), format);
+		EXPECT_EQ(buffer, out.str());
+
+		std::istringstream in(out.str());
+		Maze from_stream = Maze::readText(in, format);
+		Maze from_buffer = Maze::readText(buffer.data(), buffer.size(), format);
+		ASSERT_EQ(from_stream.getRows(), 20);
+		ASSERT_EQ(from_stream.getCols(), 25);
+		EXPECT_EQ(from_stream.getCell(3,0).getContents(), Contents::START);
+		for (int cell_i = 0; cell_i < maze.getSize(); cell_i++){
+			ASSERT_EQ(from_stream.isBlocked(cell_i), maze.isBlocked(cell_i));
+			ASSERT_EQ(from_buffer.isBlocked(cell_i), maze.isBlocked(cell_i));
+		}
+	}
+}
+
+TEST(MazeTextTest, reads_hand_written_mazes){
+	// toString() output, path included, reads back as the same maze.
+	Maze        default_maze(Position(0,0), Position(9,9), 10, 10, 1, 0.2);
+	Maze::bfs(&default_maze);
+	std::string text = default_maze.toString();
+	Maze        copy = Maze::readText(text.data(), text.size());
+	EXPECT_EQ(copy.toString(), "| S |   |   |   |   |   | x | x |   |   |\n|   |   | x |   |   | x |   | x |   |   |\n|   |   |   |   | x |   |   |   |   |   |\n|   |   |   |   |   |   |   |   |   |   |\n|   |   |   |   |   |   | x |   | x |   |\n|   | x |   |   | x | x |   |   |   |   |\n|   |   |   |   | x |   | x |   |   |   |\n|   |   | x |   |   |   |   | x |   |   |\n|   |   |   |   |   |   |   |   | x |   |\n| x |   |   |   | x |   | x | x |   | G |");
+
+	std::string compact = "S..x\r\n.x..\r\n...G\r\n";
+	Maze        small   = Maze::readText(compact.data(), compact.size(), Maze::TextFormat::COMPACT);
+	EXPECT_EQ(small.getRows(), 3);
+	EXPECT_EQ(small.getCols(), 4);
+	EXPECT_EQ(small.connected(Position(0,0), Position(2,3)), true);
+
+	std::string ragged = "S..\n..G.\n";
+	EXPECT_THROW(Maze::readText(ragged.data(), ragged.size(), Maze::TextFormat::COMPACT), std::invalid_argument);
+	std::string no_goal = "| S |   |\n";
+	EXPECT_THROW(Maze::readText(no_goal.data(), no_goal.size()), std::invalid_argument);
+}
+
+//					****** INSTRUMENTATION TESTS ******
+
+TEST(SearchStatsTest, counts_the_work_of_a_search){
+	SearchContext context;
+	Maze          maze(Position(0,0), Position(19,19), 20, 20, 3, 0.2);
+	SearchResult  result = Maze::a_star(maze, context, Position(0,0), Position(19,19));
+	ASSERT_TRUE(result.path_found);
+
+	EXPECT_EQ(result.stats.queries, 1);
+	EXPECT_EQ(result.stats.found, 1);
+	EXPECT_EQ(result.stats.pushed, result.push_count);
+	EXPECT_GE(result.stats.expanded, result.path_length);
+	EXPECT_GT(result.stats.peak_frontier, 0);
+	EXPECT_GE(result.stats.peak_scratch_bytes, maze.getSize() * (sizeof(int) + sizeof(double)));
+
+	// JPS and the bidirectional searches fill in the same counters.
+	for (SearchResult other: {
+		Maze::jps(maze, context, Position(0,0), Position(19,19)),
+		Maze::bidirectional_a_star(maze, context, Position(0,0), Position(19,19))
+	}){
+		EXPECT_EQ(other.stats.found, 1);
+		EXPECT_EQ(other.stats.pushed, other.push_count);
+		EXPECT_GT(other.stats.expanded, 0);
+	}
+}
+
+TEST(SearchStatsTest, batches_aggregate_and_export){
+	Maze                   maze(Position(0,0), Position(29,29), 30, 30, 5, 0.25);
+	std::vector<PathQuery> queries(16, PathQuery{Position(0,0), Position(29,29)});
+	BatchQueryEngine       engine(maze, 2);
+	std::vector<SearchResult> results = engine.run(queries);
+
+	SearchStats total = BatchQueryEngine::summarize(results);
+	EXPECT_EQ(total.queries, 16);
+	EXPECT_EQ(total.found, 16 * results[0].stats.found);
+	EXPECT_EQ(total.expanded, 16 * results[0].stats.expanded);
+	EXPECT_EQ(total.peak_frontier, results[0].stats.peak_frontier);
+
+	std::ostringstream json;
+	total.writeJson(json);
+	EXPECT_EQ(json.str().front(), '{');
+	EXPECT_NE(json.str().find("\"queries\":16"), std::string::npos);
+
+	std::ostringstream csv;
+	SearchStats::writeCsvHeader(csv);
+	total.writeCsv(csv);
+	std::string header = csv.str().substr(0, csv.str().find('\n'));
+	std::string row    = csv.str().substr(header.size() + 1);
+	EXPECT_EQ(std::count(header.begin(), header.end(), ','), std::count(row.begin(), row.end(), ','));
+	EXPECT_EQ(row.substr(0, 3), "16,");
+}
+
+//					****** BIT WAVEFRONT TESTS ******
+
+TEST(BitWavefrontTest, distances_match_bfs){
+	SearchContext context;
+	std::mt19937  rng(19);
+	// Widths on both sides of word boundaries.
+	for (int cols: {7, 64, 65, 130}){
+		Maze         maze(Position(0,0), Position(39, cols-1), 40, cols, cols, 0.3);
+		BitWavefront wavefront(maze);
+		for (int query_i = 0; query_i < 20; query_i++){
+			Position from(rng() % 40, rng() % cols);
+			Position to(rng() % 40, rng() % cols);
+			if (maze.isBlocked(maze.toIndex(from)) || maze.isBlocked(maze.toIndex(to))){ continue; }
+			if (from.row == to.row && from.col == to.col){ continue; }
+
+			SearchResult bfs = Maze::bfs(maze, context, from, to);
+			EXPECT_EQ(wavefront.distance(from, to), bfs.path_found ? bfs.path_length + 1 : -1);
+		}
+
+		std::vector<int> field = wavefront.distanceField(Position(0,0));
+		size_t reachable = 0;
+		for (int cell_i = 0; cell_i < maze.getSize(); cell_i++){
+			EXPECT_EQ(field[cell_i] != -1, maze.connected(Position(0,0), maze.toPosition(cell_i)) && !maze.isBlocked(cell_i));
+			reachable += (field[cell_i] != -1);
+		}
+		EXPECT_EQ(wavefront.reached().count(), reachable);
+		EXPECT_EQ(field[maze.toIndex(Position(0,0))], 0);
+	}
+}
+
+TEST(BitWavefrontTest, follows_maze_edits){
+	Maze         maze(Position(0,0), Position(4,4), 5, 5, 1, 0.0);
+	BitWavefront wavefront(maze);
+	EXPECT_EQ(wavefront.distance(Position(0,0), Position(4,4)), 8);
+
+	for (int row_i = 0; row_i < 4; row_i++){ maze.markAsBlocked(row_i, 2); }
+	EXPECT_EQ(wavefront.distance(Position(0,0), Position(4,4)), 8);
+	maze.markAsBlocked(4, 2);
+	EXPECT_EQ(wavefront.distance(Position(0,0), Position(4,4)), -1);
+	EXPECT_EQ(wavefront.reached().count(), 10);
+}
+
+TEST(BitWavefrontTest, reachable_set_matches_components){
+	for (int cols: {9, 64, 100}){
+		Maze         maze(Position(0,0), Position(49, cols-1), 50, cols, cols + 1, 0.35);
+		BitWavefront wavefront(maze);
+		for (Position source: {Position(0,0), Position(25, cols/2), Position(49, cols-1)}){
+			if (maze.isBlocked(maze.toIndex(source))){ continue; }
+			std::vector<int> field = wavefront.distanceField(source);
+			const BitGrid&   reach = wavefront.reachable(source);
+			for (int cell_i = 0; cell_i < maze.getSize(); cell_i++){
+				Position pos = maze.toPosition(cell_i);
+				EXPECT_EQ(reach.test(pos.row, pos.col), field[cell_i] != -1);
+			}
+		}
+	}
+}
+
+//					****** PARALLEL BFS TESTS ******
+
+TEST(ParallelBfsTest, distances_match_bfs){
+	SearchContext context;
+	SearchContext parallel_context;
+	for (unsigned threads: {1u, 2u, 4u, 7u}){
+		for (int seed = 0; seed < 5; seed++){
+			Maze        maze(Position(0,0), Position(59,79), 60, 80, seed, 0.3);
+			ParallelBfs parallel(maze, threads);
+
+			SearchResult expected = Maze::bfs(maze, context, Position(0,0), Position(59,79));
+			SearchResult result   = parallel.search(parallel_context, Position(0,0), Position(59,79));
+			ASSERT_EQ(result.path_found, expected.path_found);
+			EXPECT_EQ(result.path_length, expected.path_length);
+			if (!result.path_found){ continue; }
+			EXPECT_EQ(result.stats.pushed, result.push_count);
+			EXPECT_GT(result.stats.expanded, 0);
+			EXPECT_GT(result.stats.peak_frontier, 0);
+
+			// The path must be a real one: consecutive cells adjacent and free.
+			const std::vector<int>& path = parallel_context.path;
+			for (int i = 1; i < path.size(); i++){
+				EXPECT_EQ(maze.manhattan(maze.toPosition(path[i-1]), maze.toPosition(path[i])), 1);
+				EXPECT_FALSE(maze.isBlocked(path[i]));
+			}
+		}
+	}
+}
+
+TEST(ParallelBfsTest, distance_field_matches_bit_wavefront){
+	Maze             maze(Position(0,0), Position(99,99), 100, 100, 20, 0.25);
+	ParallelBfs      parallel(maze, 4);
+	BitWavefront     wavefront(maze);
+	for (Position source: {Position(0,0), Position(50,50)}){
+		if (maze.isBlocked(maze.toIndex(source))){ continue; }
+		EXPECT_EQ(parallel.distanceField(source), wavefront.distanceField(source));
+	}
+	EXPECT_EQ(ParallelBfs(maze, 0).threadCount(), 1);
+}
+
+//					****** PARALLEL A* TESTS ******
+
+TEST(ParallelAStarTest, finds_optimal_paths){
+	SearchContext context;
+	SearchContext parallel_context;
+	for (unsigned threads: {1u, 2u, 4u, 7u}){
+		for (int seed = 0; seed < 8; seed++){
+			Maze          maze(Position(0,0), Position(49,69), 50, 70, seed, 0.3);
+			ParallelAStar parallel(maze, threads);
+			Position      goal = maze.toPosition(maze.getSize() - 1);
+
+			SearchResult expected = Maze::a_star(maze, context, Position(0,0), goal);
+			SearchResult result   = parallel.search(parallel_context, Position(0,0), goal);
+			ASSERT_EQ(result.path_found, expected.path_found);
+			EXPECT_EQ(result.path_length, expected.path_length);
+			if (!result.path_found){ continue; }
+
+			const std::vector<int>& path = parallel_context.path;
+			EXPECT_EQ(path.front(), 0);
+			EXPECT_EQ(path.back(), maze.getSize() - 1);
+			for (int i = 1; i < path.size(); i++){
+				EXPECT_EQ(maze.manhattan(maze.toPosition(path[i-1]), maze.toPosition(path[i])), 1);
+				EXPECT_FALSE(maze.isBlocked(path[i]));
+			}
+		}
+	}
+}
+
+TEST(ParallelAStarTest, answers_repeated_queries){
+	Maze          maze(Position(0,0), Position(39,39), 40, 40, 11, 0.2);
+	ParallelAStar parallel(maze, 3);
+	SearchContext context;
+	SearchContext parallel_context;
+	std::mt19937  rng(21);
+	for (int query_i = 0; query_i < 30; query_i++){
+		Position from(rng() % 40, rng() % 40);
+		Position to(rng() % 40, rng() % 40);
+		if (maze.isBlocked(maze.toIndex(from)) || maze.isBlocked(maze.toIndex(to))){ continue; }
+		if (from.row == to.row && from.col == to.col){ continue; }
+		EXPECT_EQ(parallel.search(parallel_context, from, to).path_length, Maze::a_star(maze, context, from, to).path_length);
+	}
+}
+
+//					****** LANDMARK TESTS ******
+
+TEST(LandmarkTest, finds_optimal_paths_with_fewer_pushes){
+	SearchContext context;
+	std::mt19937  rng(22);
+	int           a_star_pushes   = 0;
+	int           landmark_pushes = 0;
+	for (int seed = 0; seed < 10; seed++){
+		Maze         maze(Position(0,0), Position(59,59), 60, 60, seed, 0.35);
+		Landmarks    landmarks(maze, 6);
+		BitWavefront wavefront(maze);
+		EXPECT_EQ(landmarks.count(), 6);
+
+		for (int query_i = 0; query_i < 10; query_i++){
+			Position from(rng() % 60, rng() % 60);
+			Position to(rng() % 60, rng() % 60);
+			if (!maze.connected(from, to) || maze.toIndex(from) == maze.toIndex(to)){ continue; }
+
+			SearchResult expected = Maze::a_star(maze, context, from, to);
+			SearchResult result   = landmarks.search(context, from, to);
+			ASSERT_EQ(result.path_found, expected.path_found);
+			EXPECT_EQ(result.path_length, expected.path_length);
+			a_star_pushes   += expected.push_count;
+			landmark_pushes += result.push_count;
+
+			// Never above the real distance.
+			std::vector<int>  to_goal = wavefront.distanceField(to);
+			LandmarkHeuristic heuristic(maze, landmarks, to);
+			for (int cell_i = 0; cell_i < maze.getSize(); cell_i++){
+				if (to_goal[cell_i] != -1){ EXPECT_LE(heuristic(cell_i), to_goal[cell_i]); }
+			}
+		}
+	}
+	EXPECT_GT(a_star_pushes, 0);
+	EXPECT_LT(landmark_pushes, a_star_pushes);
+}
+
+TEST(LandmarkTest, builds_after_edits){
+	// Two walls make three components, then a gap in one joins two of them
+	// again, so the labels in use are no longer 0..count-1. The largest
+	// one must still be found without reading past the per-label sizes.
+	Maze          maze(Position(0,0), Position(39,39), 40, 40, 5, 0.0);
+	SearchContext context;
+	std::mt19937  rng(5);
+	for (int col_i = 0; col_i < 40; col_i++){ maze.markAsBlocked(5, col_i); }
+	for (int col_i = 0; col_i < 40; col_i++){ maze.markAsBlocked(25, col_i); }
+	maze.markAsEmpty(5, 5);
+	ASSERT_EQ(maze.componentCount(), 2);
+	ASSERT_GE(std::max(maze.componentOf(Position(0,0)), maze.componentOf(Position(39,39))), maze.componentCount());
+
+	Landmarks landmarks(maze, 4);
+	ASSERT_GT(landmarks.count(), 0);
+	int largest = maze.componentOf(maze.toPosition(landmarks.getCells()[0]));
+	for (int label = 0; label < maze.labelBound(); label++){
+		EXPECT_LE(maze.componentSize(label), maze.componentSize(largest));
+	}
+	for (int query_i = 0; query_i < 20; query_i++){
+		Position from(rng() % 40, rng() % 40);
+		Position to(rng() % 40, rng() % 40);
+		if (!maze.connected(from, to)){ continue; }
+		EXPECT_EQ(landmarks.search(context, from, to).path_length, Maze::a_star(maze, context, from, to).path_length);
+	}
+}
+
+TEST(LandmarkTest, rebuilds_with_the_requested_count){
+	Maze          maze(Position(0,0), Position(0,1), 10, 10, 1, 0.0);
+	SearchContext context;
+	for (int col = 2; col < 10; col++){ maze.markAsBlocked(0, col); }
+	for (int row = 1; row < 10; row++){
+		for (int col = 0; col < 10; col++){ maze.markAsBlocked(row, col); }
+	}
+	Landmarks landmarks(maze, 4);
+	EXPECT_LT(landmarks.count(), 4);	// the free cells run out first
+
+	for (int col = 2; col < 10; col++){ maze.markAsEmpty(0, col); }
+	for (int row = 1; row < 10; row++){
+		for (int col = 0; col < 10; col++){ maze.markAsEmpty(row, col); }
+	}
+	EXPECT_TRUE(landmarks.search(context, Position(0,0), Position(9,9)).path_found);
+	EXPECT_EQ(landmarks.count(), 4);
+}
+
+TEST(LandmarkTest, tables_are_saved_with_the_maze){
+	std::string   path = testing::TempDir() + "landmark_test.bin";
+	Maze          maze(Position(0,0), Position(39,49), 40, 50, 3, 0.3);
+	Landmarks     built(maze, 4);
+	SearchContext context;
+	maze.save(path, &built);
+
+	Maze      opened    = Maze::open(path);
+	Landmarks landmarks = Landmarks::open(opened, path);
+	EXPECT_TRUE(landmarks.isMapped());
+	ASSERT_EQ(landmarks.getCells(), built.getCells());
+	for (int cell_i = 0; cell_i < maze.getSize(); cell_i++){
+		for (int landmark_k = 0; landmark_k < built.count(); landmark_k++){
+			ASSERT_EQ(landmarks.distance(landmark_k, cell_i), built.distance(landmark_k, cell_i));
+		}
+	}
+	EXPECT_EQ(
+		landmarks.search(context, Position(0,0), Position(39,49)).path_length,
+		Maze::a_star(maze, context, Position(0,0), Position(39,49)).path_length);
+
+	// Edits make the tables stale; the next search rebuilds them in memory.
+	opened.labelComponents();
+	for (int col_i = 0; col_i < 50; col_i++){ opened.markAsBlocked(20, col_i); }
+	SearchResult after = landmarks.search(context, Position(0,0), Position(39,49));
+	EXPECT_FALSE(landmarks.isMapped());
+	EXPECT_EQ(after.path_length, Maze::a_star(opened, context, Position(0,0), Position(39,49)).path_length);
+
+	maze.save(path);
+	EXPECT_THROW(Landmarks::open(maze, path), std::invalid_argument);
+	std::remove(path.c_str());
+}
+
+//					****** FLOW FIELD TESTS ******
+
+TEST(FlowFieldTest, paths_match_bfs_for_every_start){
+	Maze          maze(Position(0,0), Position(39,39), 40, 40, 23, 0.3);
+	Position      goal(17, 22);
+	FlowField     field(maze, goal);
+	SearchContext bfs_context;
+	SearchContext field_context;
+	for (int cell_i = 0; cell_i < maze.getSize(); cell_i++){
+		if (maze.isBlocked(cell_i)){ continue; }
+		Position     start    = maze.toPosition(cell_i);
+		SearchResult expected = Maze::bfs(maze, bfs_context, start, goal);
+		SearchResult result   = field.search(field_context, start);
+		ASSERT_EQ(result.path_found, expected.path_found);
+		if (!result.path_found){
+			EXPECT_EQ(field.distanceOf(cell_i), -1);
+			continue;
+		}
+		EXPECT_EQ(result.path_length, expected.path_length);
+		EXPECT_EQ(field.distanceOf(cell_i), int(field_context.path.size()) - 1);
+		EXPECT_EQ(result.push_count, int(field_context.path.size()));
+		EXPECT_EQ(result.stats.queries, 1);
+		EXPECT_EQ(result.stats.expanded, field_context.path.size());
+		EXPECT_EQ(field_context.path.front(), cell_i);
+		EXPECT_EQ(field_context.path.back(), maze.toIndex(goal));
+		for (size_t step_i = 1; step_i < field_context.path.size(); step_i++){
+			Position from = maze.toPosition(field_context.path[step_i - 1]);
+			Position to   = maze.toPosition(field_context.path[step_i]);
+			EXPECT_FALSE(maze.isBlocked(field_context.path[step_i]));
+			EXPECT_EQ(maze.manhattan(from, to), 1);
+		}
+	}
+}
+
+TEST(FlowFieldTest, cache_is_reused_and_dropped_on_edits){
+	Maze           maze(Position(0,0), Position(0,29), 30, 30, 4, 0.0);
+	FlowFieldCache cache(maze, 2);
+	SearchContext  context;
+	Position       goal(0, 0);
+
+	std::shared_ptr<const FlowField> first = cache.field(goal);
+	EXPECT_EQ(cache.field(goal), first);
+	cache.field(Position(29,29));
+	cache.field(Position(15,15));	// evicts (0,0), the least recently used
+	EXPECT_EQ(cache.size(), 2u);
+	EXPECT_NE(cache.field(goal), first);
+
+	// Walling off the bottom right corner changes every field that reaches it.
+	first = cache.field(goal);
+	maze.markAsBlocked(28, 29);
+	maze.markAsBlocked(29, 28);
+	SearchResult after = cache.search(context, Position(29,29), goal);
+	EXPECT_FALSE(after.path_found);
+	EXPECT_NE(cache.field(goal), first);
+	EXPECT_EQ(cache.search(context, Position(10,10), goal).path_length,
+		Maze::bfs(maze, context, Position(10,10), goal).path_length);
+	EXPECT_EQ(first->distanceOf(maze.toIndex(Position(29,29))), 58);	// the old field is still readable
+
+	// (29,29) is now cut off, so blocking it cannot change the goal's field.
+	first = cache.field(goal);
+	maze.markAsBlocked(29, 29);
+	EXPECT_EQ(cache.field(goal), first);
+}
+
+TEST(FlowFieldTest, field_of_a_blocked_goal_is_dropped_when_it_is_freed){
+	Maze           maze(Position(0,0), Position(19,19), 20, 20, 4, 0.0);
+	FlowFieldCache cache(maze, 4);
+	SearchContext  context;
+	Position       goal(10, 10);
+
+	maze.markAsBlocked(goal.row, goal.col);
+	EXPECT_FALSE(cache.search(context, Position(0,0), goal).path_found);
+	maze.markAsEmpty(goal.row, goal.col);
+	SearchResult result = cache.search(context, Position(0,0), goal);
+	EXPECT_TRUE(result.path_found);
+	EXPECT_EQ(result.path_length, Maze::bfs(maze, context, Position(0,0), goal).path_length);
+}
+
+//					****** SLICED SEARCH TESTS ******
+
+TEST(SlicedSearchTest, matches_the_search_it_slices){
+	Maze          maze(Position(0,0), Position(49,49), 50, 50, 24, 0.3);
+	SearchContext context;
+	SearchContext sliced_context;
+	std::mt19937  rng(24);
+	for (int query_i = 0; query_i < 20; query_i++){
+		Position from(rng() % 50, rng() % 50);
+		Position to(rng() % 50, rng() % 50);
+		if (maze.isBlocked(maze.toIndex(from)) || maze.isBlocked(maze.toIndex(to))){ continue; }
+
+		for (auto [search, sliced]: {
+			std::pair{static_cast<BatchQueryEngine::QueryFunction>(&Maze::dfs),    &slicedDfs},
+			std::pair{static_cast<BatchQueryEngine::QueryFunction>(&Maze::bfs),    &slicedBfs},
+			std::pair{static_cast<BatchQueryEngine::QueryFunction>(&Maze::a_star), &slicedAStar}}){
+			SearchResult expected = search(maze, context, from, to);
+			SearchTask   task     = sliced(maze, sliced_context, from, to);
+			int          expanded = 0;
+			while (!task.resume(SliceBudget{7})){
+				EXPECT_EQ(task.progress().expanded, expanded + 7);
+				expanded = task.progress().expanded;
+				EXPECT_NE(task.progress().closest_i, -1);
+			}
+			EXPECT_EQ(task.result().path_found,  expected.path_found);
+			EXPECT_EQ(task.result().path_length, expected.path_length);
+			EXPECT_EQ(task.result().push_count,  expected.push_count);
+			EXPECT_EQ(sliced_context.path,       context.path);
+		}
+	}
+}
+
+TEST(SlicedSearchTest, scheduler_interleaves_searches){
+	Maze            maze(Position(0,0), Position(59,59), 60, 60, 25, 0.2);
+	SearchScheduler scheduler(maze);
+	SearchContext   context;
+	std::vector<std::pair<Position, Position>> queries;
+	std::mt19937 rng(25);
+	while (queries.size() < 4){
+		Position from(rng() % 60, rng() % 60);
+		Position to(rng() % 60, rng() % 60);
+		if (maze.isBlocked(maze.toIndex(from)) || maze.isBlocked(maze.toIndex(to))){ continue; }
+		queries.push_back({from, to});
+	}
+	std::vector<int> tickets;
+	for (auto [from, to]: queries){ tickets.push_back(scheduler.submit(from, to)); }
+
+	// Zero frame: one slice each per tick, so all of them move every tick.
+	scheduler.tick(SliceBudget{10});
+	for (int ticket: tickets){ EXPECT_EQ(scheduler.progress(ticket).slices, 1); }
+	while (scheduler.tick(SliceBudget{10}) > 0){}
+
+	for (size_t query_i = 0; query_i < queries.size(); query_i++){
+		auto [from, to]       = queries[query_i];
+		SearchResult expected = Maze::a_star(maze, context, from, to);
+		ASSERT_TRUE(scheduler.isDone(tickets[query_i]));
+		EXPECT_EQ(scheduler.result(tickets[query_i]).path_length, expected.path_length);
+		EXPECT_EQ(scheduler.path(tickets[query_i]), context.path);
+		scheduler.release(tickets[query_i]);
+	}
+	EXPECT_EQ(scheduler.pending(), 0u);
+
+	// A time budget still gets a search done, a few slices at a time.
+	int ticket = scheduler.submit(queries[0].first, queries[0].second, &slicedBfs);
+	scheduler.tick(SliceBudget{0, std::chrono::microseconds(50)}, std::chrono::seconds(10));
+	EXPECT_TRUE(scheduler.isDone(ticket));
+}
+
+//					****** ANYTIME A* TESTS ******
+
+TEST(AnytimeAStarTest, bounds_hold_and_end_optimal){
+	SearchContext context;
+	SearchContext anytime_context;
+	std::mt19937  rng(25);
+	for (int seed = 0; seed < 5; seed++){
+		Maze maze(Position(0,0), Position(79,79), 80, 80, seed, 0.3);
+		for (int query_i = 0; query_i < 5; query_i++){
+			Position from(rng() % 80, rng() % 80);
+			Position to(rng() % 80, rng() % 80);
+			if (!maze.connected(from, to)){ continue; }
+			int optimal = Maze::a_star(maze, context, from, to).path_length + 1;
+
+			AnytimeAStar anytime(maze, anytime_context, from, to, 3.0, 0.5);
+			double       last_epsilon = 4.0;
+			int          last_length  = std::numeric_limits<int>::max();
+			while (!anytime.isDone()){
+				const AnytimeResult& result = anytime.improve();
+				ASSERT_TRUE(result.path_found);
+				EXPECT_LT(result.epsilon, last_epsilon);
+				EXPECT_LE(result.bound, result.epsilon);
+				EXPECT_LE(result.path_length + 1, result.bound * optimal + 1e-9);
+				EXPECT_LE(result.path_length, last_length);
+				EXPECT_EQ(int(anytime_context.path.size()), result.path_length + 2);
+				last_epsilon = result.epsilon;
+				last_length  = result.path_length;
+			}
+			EXPECT_EQ(anytime.result().path_length + 1, optimal);
+			EXPECT_EQ(anytime.result().bound, 1);
+		}
+	}
+}
+
+TEST(AnytimeAStarTest, start_equal_to_goal_finishes_at_once){
+	Maze                 maze(Position(0,0), Position(19,19), 20, 20, 3, 0.0);
+	SearchContext        context;
+	AnytimeAStar         anytime(maze, context, Position(4,4), Position(4,4), 3.0, 0.5);
+	const AnytimeResult& result = anytime.improve();
+	EXPECT_TRUE(result.path_found);
+	EXPECT_EQ(result.path_length, 0);
+	EXPECT_EQ(result.bound, 1);
+	EXPECT_EQ(result.iterations, 1);
+	EXPECT_TRUE(anytime.isDone());
+}
+
+TEST(AnytimeAStarTest, first_path_is_cheaper_than_a_star){
+	Maze          maze(Position(0,0), Position(149,149), 150, 150, 7, 0.2);
+	SearchContext context;
+	SearchResult  a_star = Maze::a_star(maze, context, Position(0,0), Position(149,149));
+	ASSERT_TRUE(a_star.path_found);
+
+	SearchContext        anytime_context;
+	AnytimeAStar         anytime(maze, anytime_context, Position(0,0), Position(149,149), 3.0, 1.0);
+	const AnytimeResult& first = anytime.improve();
+	EXPECT_EQ(first.iterations, 1);
+	EXPECT_EQ(first.epsilon, 3.0);
+	EXPECT_LT(first.push_count, a_star.push_count);
+
+	// A zero budget still runs one iteration; a large one runs to the end.
+	anytime.search(std::chrono::microseconds(0));
+	EXPECT_EQ(anytime.result().iterations, 2);
+	anytime.search(std::chrono::seconds(10));
+	EXPECT_TRUE(anytime.isDone());
+	EXPECT_EQ(anytime.result().path_length, a_star.path_length);
+	EXPECT_EQ(int(anytime_context.path.size()), a_star.path_length + 2);
+
+	Maze walled(Position(0,0), Position(9,9), 10, 10, 1, 0.0);
+	for (int col_i = 0; col_i < 10; col_i++){ walled.markAsBlocked(5, col_i); }
+	AnytimeAStar cut_off(walled, context, Position(0,0), Position(9,9));
+	EXPECT_TRUE(cut_off.isDone());
+	EXPECT_FALSE(cut_off.improve().path_found);
+	EXPECT_THROW(AnytimeAStar(walled, context, Position(0,0), Position(9,9), 0.5), std::invalid_argument);
 }